@@ -0,0 +1,419 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "BandCounter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/**
+ * Renames values in order of first appearance, column by column through the stacks, so
+ * masks that differ only in labels tend to meet
+ */
+void relabel(uint16_t *cols, int side_length) {
+    int label[16];
+    int next = 0;
+    std::fill(label, label + side_length, -1);
+
+    for (int col = 0; col < side_length; ++col) {
+        for (unsigned mask = cols[col], val = 0; mask; ++val, mask >>= 1) {
+            if ((mask & 1) && label[val] < 0) {
+                label[val] = next++;
+            }
+        }
+    }
+    for (int val = 0; val < side_length; ++val) {   // values nowhere yet keep their order
+        if (label[val] < 0) {
+            label[val] = next++;
+        }
+    }
+
+    for (int col = 0; col < side_length; ++col) {
+        unsigned renamed = 0;
+        for (int val = 0; (cols[col] >> val) != 0; ++val) {
+            if (cols[col] & (1u << val)) {
+                renamed |= 1u << label[val];
+            }
+        }
+        cols[col] = (uint16_t) renamed;
+    }
+}
+
+/**
+ * Sorts the columns within every stack, then the stacks by their columns
+ */
+void sortStacks(uint16_t *cols, int stacks, int box_cols) {
+    uint16_t sorted[16 * 16];
+    uint16_t *order[16];
+
+    for (int stack = 0; stack < stacks; ++stack) {
+        order[stack] = cols + stack * box_cols;
+        std::sort(order[stack], order[stack] + box_cols);
+    }
+    std::sort(order, order + stacks, [box_cols](const uint16_t *a, const uint16_t *b) {
+        return std::lexicographical_compare(a, a + box_cols, b, b + box_cols);
+    });
+
+    for (int stack = 0; stack < stacks; ++stack) {
+        std::copy(order[stack], order[stack] + box_cols, sorted + stack * box_cols);
+    }
+    std::copy(sorted, sorted + stacks * box_cols, cols);
+}
+
+/**
+ * @return number of set bits
+ */
+int bitCount(unsigned mask) {
+    int count = 0;
+    for (; mask; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+CompletionCount &CompletionCount::operator+=(const CompletionCount &other) {
+    uint64_t low_sum = low + other.low;
+    uint64_t carry = low_sum < low ? 1 : 0;
+    uint64_t high_sum = high + other.high;
+
+    overflow |= other.overflow || high_sum < high;
+    high_sum += carry;
+    overflow |= high_sum < carry;
+
+    high = high_sum;
+    low = low_sum;
+    return *this;
+}
+
+CompletionCount &CompletionCount::operator*=(uint64_t factor) {
+    // schoolbook product over 32-bit limbs, least significant first
+    uint32_t limbs[4] = {(uint32_t) low, (uint32_t) (low >> 32), (uint32_t) high,
+                         (uint32_t) (high >> 32)};
+    uint32_t factors[2] = {(uint32_t) factor, (uint32_t) (factor >> 32)};
+    uint32_t product[6] = {0, 0, 0, 0, 0, 0};
+
+    for (int i = 0; i < 4; ++i) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 2; ++j) {
+            uint64_t current = (uint64_t) limbs[i] * factors[j] + product[i + j] + carry;
+            product[i + j] = (uint32_t) current;
+            carry = current >> 32;
+        }
+        product[i + 2] = (uint32_t) carry;
+    }
+
+    overflow |= (product[4] | product[5]) != 0;
+    low = (uint64_t) product[1] << 32 | product[0];
+    high = (uint64_t) product[3] << 32 | product[2];
+    return *this;
+}
+
+bool CompletionCount::operator==(const CompletionCount &other) const {
+    return high == other.high && low == other.low && overflow == other.overflow;
+}
+
+bool BandCounter::State::operator==(const State &other) const {
+    return std::memcmp(masks, other.masks, sizeof(masks)) == 0;
+}
+
+std::size_t BandCounter::StateHash::operator()(const State &state) const {
+    uint64_t hash = 0;
+    for (uint16_t mask : state.masks) {
+        hash = (hash ^ mask) * 0x100000001b3ull;
+    }
+    return (std::size_t) (hash ^ (hash >> 29));
+}
+
+/**
+ * @return the count in decimal, or "overflow"
+ */
+std::string CompletionCount::toString() const {
+    if (overflow) {
+        return "overflow";
+    }
+
+    // long division by 10 over four 32-bit limbs, most significant first
+    uint32_t limbs[4] = {(uint32_t) (high >> 32), (uint32_t) high, (uint32_t) (low >> 32),
+                         (uint32_t) low};
+    std::string digits;
+
+    do {
+        uint64_t remainder = 0;
+        for (uint32_t &limb : limbs) {
+            uint64_t current = remainder << 32 | limb;
+            limb = (uint32_t) (current / 10);
+            remainder = current % 10;
+        }
+        digits.push_back((char) ('0' + remainder));
+    } while (limbs[0] | limbs[1] | limbs[2] | limbs[3]);
+
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+/**
+ * @param box_rows, box_cols (box shape; the board side is their product, up to 16)
+ */
+BandCounter::BandCounter(int box_rows, int box_cols)
+        : box_rows(box_rows), box_cols(box_cols), side_length(box_rows * box_cols),
+          bands(box_cols > 0 ? box_cols : 0), stacks(box_rows > 0 ? box_rows : 0),
+          free_from(0) {
+    full_mask = (uint16_t) (side_length > 0 && side_length <= MAX_SIDE ?
+                            (1u << side_length) - 1 : 0);
+}
+
+/**
+ * Counts the completions of a board
+ *
+ * @param cells (side * side values in row-major order, 0 for empty)
+ * @param count (set to the number of completions, 0 if the givens conflict)
+ * @return false if the board shape is unsupported or the count overflowed
+ */
+bool BandCounter::count(const uint8_t *cells, CompletionCount &count) {
+    count = CompletionCount();
+    memo.clear();
+    tables.clear();
+    if (box_rows <= 0 || box_cols <= 0 || side_length > MAX_SIDE) {
+        return false;
+    }
+    for (int cell = 0; cell < side_length * side_length; ++cell) {
+        if (cells[cell] > side_length) {
+            return false;
+        }
+    }
+
+    // bands with the most givens first; reordering bands keeps the count
+    int band_cells = box_rows * side_length;
+    std::vector<std::pair<int, int>> order;          // (-givens, band)
+    for (int band = 0; band < bands; ++band) {
+        int band_givens = 0;
+        for (int cell = band * band_cells; cell < (band + 1) * band_cells; ++cell) {
+            band_givens += cells[cell] != 0;
+        }
+        order.push_back(std::pair<int, int>(-band_givens, band));
+    }
+    std::stable_sort(order.begin(), order.end());
+
+    givens.clear();
+    given_sets.assign(bands * side_length, 0);
+    free_from = 0;
+    for (int band = 0; band < bands; ++band) {
+        const uint8_t *first = cells + order[band].second * band_cells;
+        givens.insert(givens.end(), first, first + band_cells);
+        for (int cell = 0; cell < band_cells; ++cell) {
+            if (first[cell] != 0) {
+                given_sets[band * side_length + cell % side_length] |=
+                    (uint16_t) (1u << (first[cell] - 1));
+            }
+        }
+        if (order[band].first != 0) {
+            free_from = band + 1;
+        }
+    }
+
+    uint16_t used[MAX_SIDE] = {0};
+    count = countFrom(0, used);
+    return !count.overflow;
+}
+
+/**
+ * @return number of band states and table entries memoized by the last count
+ */
+std::size_t BandCounter::getStateCount() const {
+    return memo.size() + tables.size();
+}
+
+/**
+ * @param used (values per column above band)
+ * @return completions of band and the bands below it
+ */
+CompletionCount BandCounter::countFrom(int band, const uint16_t *used) {
+    if (band == bands) {
+        return CompletionCount(1);
+    }
+
+    bool keyed = band < bands - 1;               // the last band is forced, not worth a key
+    State key;
+    if (keyed) {
+        key = stateKey(band, used, band >= free_from);
+        std::unordered_map<State, CompletionCount, StateHash>::const_iterator known =
+            memo.find(key);
+        if (known != memo.end()) {
+            return known->second;
+        }
+    }
+
+    std::vector<uint16_t> splits[MAX_SIDE];
+    uint16_t split[MAX_SIDE];
+    CompletionCount total;
+    bool splittable = true;
+    for (int stack = 0; stack < stacks && splittable; ++stack) {
+        std::fill(split, split + box_cols, 0);
+        splitStack(band, stack, used, 0, split, splits[stack]);
+        splittable = !splits[stack].empty();
+    }
+
+    if (splittable) {
+        uint64_t symmetric = 1;
+        if (band == 0 && free_from == 0) {
+            symmetric = splits[0].size() / box_cols;
+            splits[0].resize(box_cols);
+        }
+        combine(band, used, splits, 0, split, total);
+        total *= symmetric;
+    }
+
+    if (keyed) {
+        memo[key] = total;
+    }
+    return total;
+}
+
+/**
+ * Combines the splits of stack and the stacks after it, adding up the completions of
+ * every full split
+ */
+void BandCounter::combine(int band, const uint16_t *used, const std::vector<uint16_t> *splits,
+                          int stack, uint16_t *split, CompletionCount &total) {
+    if (stack == stacks) {
+        uint64_t ways = arrangements(band, split);
+        if (ways == 0) {
+            return;
+        }
+
+        uint16_t below[MAX_SIDE];
+        for (int col = 0; col < side_length; ++col) {
+            below[col] = (uint16_t) (used[col] | split[col]);
+        }
+        CompletionCount completions = countFrom(band + 1, below);
+        completions *= ways;
+        total += completions;
+        return;
+    }
+
+    const std::vector<uint16_t> &options = splits[stack];
+    for (std::size_t at = 0; at < options.size(); at += box_cols) {
+        std::copy(options.begin() + at, options.begin() + at + box_cols,
+                  split + stack * box_cols);
+        combine(band, used, splits, stack + 1, split, total);
+    }
+}
+
+/**
+ * Deals the values from val on over the columns of stack, appending every full split
+ */
+void BandCounter::splitStack(int band, int stack, const uint16_t *used, int val,
+                             uint16_t *split, std::vector<uint16_t> &splits) const {
+    int first = stack * box_cols;
+    if (val == side_length) {
+        for (int x = 0; x < box_cols; ++x) {
+            if ((given_sets[band * side_length + first + x] & ~split[x]) != 0) {
+                return;
+            }
+        }
+        splits.insert(splits.end(), split, split + box_cols);
+        return;
+    }
+
+    // a value given in the band goes to its column; otherwise to any with room for it
+    uint16_t bit = (uint16_t) (1u << val);
+    bool given = false;
+    for (int x = 0; x < box_cols; ++x) {
+        given |= (given_sets[band * side_length + first + x] & bit) != 0;
+    }
+
+    for (int x = 0; x < box_cols; ++x) {
+        bool wanted = !given || (given_sets[band * side_length + first + x] & bit) != 0;
+        if (wanted && !(used[first + x] & bit) && bitCount(split[x]) < box_rows) {
+            split[x] |= bit;
+            splitStack(band, stack, used, val + 1, split, splits);
+            split[x] &= (uint16_t) ~bit;
+        }
+    }
+}
+
+/**
+ * @param split (values of every column in band)
+ * @return ways to arrange the rows of band over split, from the completion table
+ */
+uint64_t BandCounter::arrangements(int band, const uint16_t *split) {
+    // without givens the rows do not care which band they are in
+    bool free = true;
+    for (int col = 0; col < side_length; ++col) {
+        free &= given_sets[band * side_length + col] == 0;
+    }
+
+    State key = stateKey(free ? bands : band, split, free);
+    std::unordered_map<State, uint64_t, StateHash>::const_iterator known = tables.find(key);
+    if (known != tables.end()) {
+        return known->second;
+    }
+
+    uint16_t left[MAX_SIDE];
+    std::copy(split, split + side_length, left);
+    uint64_t ways = arrange(band, 0, 0, 0, left);
+    tables[key] = ways;
+    return ways;
+}
+
+/**
+ * Enumerates the values of a band's rows from row and col on
+ *
+ * @param left (values per column not yet placed in the band)
+ * @return number of arrangements
+ */
+uint64_t BandCounter::arrange(int band, int row, int col, uint16_t row_used,
+                              uint16_t *left) const {
+    const uint8_t *band_givens = &givens[(band * box_rows + row) * side_length];
+
+    if (row == box_rows - 1) {                   // the last row takes what is left
+        unsigned row_values = 0;
+        for (int x = 0; x < side_length; ++x) {
+            if (band_givens[x] != 0 && left[x] != 1u << (band_givens[x] - 1)) {
+                return 0;
+            }
+            row_values |= left[x];
+        }
+        return row_values == full_mask ? 1 : 0;
+    }
+    if (col == side_length) {
+        return arrange(band, row + 1, 0, 0, left);
+    }
+
+    unsigned options = left[col] & ~row_used;
+    if (band_givens[col] != 0) {
+        options &= 1u << (band_givens[col] - 1);
+    }
+
+    uint64_t ways = 0;
+    for (; options; options &= options - 1) {
+        uint16_t bit = (uint16_t) (options & (~options + 1));
+        left[col] &= (uint16_t) ~bit;
+        ways += arrange(band, row, col + 1, (uint16_t) (row_used | bit), left);
+        left[col] |= bit;
+    }
+    return ways;
+}
+
+/**
+ * @return memo key of band and masks, reduced under the column, stack and value
+ * symmetries if reduce is set
+ */
+BandCounter::State BandCounter::stateKey(int band, const uint16_t *masks, bool reduce) const {
+    State key;
+    std::fill(key.masks, key.masks + 1 + MAX_SIDE, 0);
+    key.masks[0] = (uint16_t) band;
+    std::copy(masks, masks + side_length, key.masks + 1);
+
+    if (reduce) {
+        // both steps map the masks to equivalent ones; repeating them merges no more
+        relabel(key.masks + 1, side_length);
+        sortStacks(key.masks + 1, stacks, box_cols);
+    }
+    return key;
+}
@@ -0,0 +1,148 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef BAND_COUNTER_H
+#define BAND_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Unsigned 128-bit count, enough for every completion count up to 9 x 9 (an empty
+ * 9 x 9 board has about 6.7e21). Sums and products past 2^128 set overflow instead of
+ * wrapping.
+ */
+struct CompletionCount {
+    uint64_t high;
+    uint64_t low;
+    bool overflow;
+
+    CompletionCount(uint64_t low = 0) : high(0), low(low), overflow(false) {
+    }
+
+    CompletionCount &operator+=(const CompletionCount &other);
+
+    CompletionCount &operator*=(uint64_t factor);
+
+    bool operator==(const CompletionCount &other) const;
+
+    /**
+    * @return the count in decimal, or "overflow"
+    */
+    std::string toString() const;
+};
+
+/**
+ * Exact counter of the completions of a partially filled board with box_rows x box_cols
+ * boxes (4 x 4, 6 x 6 with 2 x 3 boxes, 8 x 8, 9 x 9, ...), for counts far past what
+ * enumerating solutions can reach.
+ *
+ * The board is filled one band at a time. Every box of a band holds each value once, so
+ * a band is first split: each stack's values are dealt over its columns, box_rows to a
+ * column, avoiding the values the column already holds. The splits of different stacks
+ * are independent; the rows below only see the columns' values, and the number of ways
+ * to arrange a band's rows over a given split comes from a band completion table. Both
+ * the count below a band and the table are memoized; bands are reordered so the givens
+ * come first, and once no givens are left a key is reduced under swapping columns
+ * within a stack, swapping stacks and relabeling values, so one entry stands for a
+ * whole family of splits. On an empty board the first stack's split is fixed outright,
+ * as relabeling maps every split of it to every other.
+ */
+class BandCounter {
+
+public:
+    /**
+    * @param box_rows, box_cols (box shape; the board side is their product, up to 16)
+    */
+    BandCounter(int box_rows, int box_cols);
+
+    /**
+    * Counts the completions of a board
+    *
+    * @param cells (side * side values in row-major order, 0 for empty)
+    * @param count (set to the number of completions, 0 if the givens conflict)
+    * @return false if the board shape is unsupported or the count overflowed
+    */
+    bool count(const uint8_t *cells, CompletionCount &count);
+
+    /**
+    * @return number of band states and table entries memoized by the last count
+    */
+    std::size_t getStateCount() const;
+
+private:
+    static const int MAX_SIDE = 16;
+
+    /**
+     * Memo key: a band and one value mask per column (the values above the band, or the
+     * values of its split)
+     */
+    struct State {
+        uint16_t masks[1 + MAX_SIDE];
+
+        bool operator==(const State &other) const;
+    };
+
+    struct StateHash {
+        std::size_t operator()(const State &state) const;
+    };
+
+    int box_rows;
+    int box_cols;
+    int side_length;
+    int bands;
+    int stacks;
+    uint16_t full_mask;               // bit (v - 1) set for every value 1..side_length
+
+    std::vector<uint8_t> givens;      // board with its bands reordered
+    std::vector<uint16_t> given_sets; // values given per band and column
+    int free_from;                    // first band with no givens at or below it
+    std::unordered_map<State, CompletionCount, StateHash> memo;
+    std::unordered_map<State, uint64_t, StateHash> tables;
+
+    /**
+    * @param used (values per column above band)
+    * @return completions of band and the bands below it
+    */
+    CompletionCount countFrom(int band, const uint16_t *used);
+
+    /**
+    * Combines the splits of stack and the stacks after it, adding up the completions of
+    * every full split
+    */
+    void combine(int band, const uint16_t *used, const std::vector<uint16_t> *splits,
+                 int stack, uint16_t *split, CompletionCount &total);
+
+    /**
+    * Deals the values from val on over the columns of stack, appending every full split
+    */
+    void splitStack(int band, int stack, const uint16_t *used, int val, uint16_t *split,
+                    std::vector<uint16_t> &splits) const;
+
+    /**
+    * @param split (values of every column in band)
+    * @return ways to arrange the rows of band over split, from the completion table
+    */
+    uint64_t arrangements(int band, const uint16_t *split);
+
+    /**
+    * Enumerates the values of a band's rows from row and col on
+    *
+    * @param left (values per column not yet placed in the band)
+    * @return number of arrangements
+    */
+    uint64_t arrange(int band, int row, int col, uint16_t row_used, uint16_t *left) const;
+
+    /**
+    * @return memo key of band and masks, reduced under the column, stack and value
+    * symmetries if reduce is set
+    */
+    State stateKey(int band, const uint16_t *masks, bool reduce) const;
+};
+
+#endif // ends BAND_COUNTER_H
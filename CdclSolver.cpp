@@ -0,0 +1,654 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "CdclSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const uint8_t CdclSolver::VALUE_FALSE;
+const uint8_t CdclSolver::VALUE_TRUE;
+const uint8_t CdclSolver::VALUE_UNDEF;
+
+CdclSolver::CdclSolver()
+        : var_count(0), unsatisfiable(false), cancel_flag(nullptr), wasted(0), qhead(0),
+          var_inc(1.0), clause_inc(1.0f) {
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * Clears every clause and sets the number of variables
+ */
+void CdclSolver::reset(int new_var_count) {
+    var_count = new_var_count;
+    unsatisfiable = false;
+    std::memset(&stats, 0, sizeof(stats));
+
+    arena.clear();
+    learnts.clear();
+    wasted = 0;
+
+    watches.assign(2 * var_count, std::vector<Watcher>());
+    assigns.assign(var_count, VALUE_UNDEF);
+    phase.assign(var_count, VALUE_FALSE);
+    level.assign(var_count, 0);
+    reason.assign(var_count, -1);
+    trail.clear();
+    trail_lim.clear();
+    qhead = 0;
+
+    activity.assign(var_count, 0.0);
+    var_inc = 1.0;
+    clause_inc = 1.0f;
+    heap.clear();
+    heap_index.assign(var_count, -1);
+    for (int var = 0; var < var_count; ++var) {
+        heapInsert(var);
+    }
+
+    seen.assign(var_count, 0);
+    model.clear();
+}
+
+/**
+ * Adds a problem clause. Literals false at level 0 are dropped, clauses already true at
+ * level 0 are skipped and unit clauses are assigned straight away.
+ *
+ * @param lits (literals of the clause; duplicates and tautologies are handled)
+ * @return false if the formula is now known to be unsatisfiable
+ */
+bool CdclSolver::addClause(const std::vector<int> &lits) {
+    if (unsatisfiable) {
+        return false;
+    }
+
+    learnt.assign(lits.begin(), lits.end());
+    std::sort(learnt.begin(), learnt.end());
+
+    int kept = 0;
+    for (int x = 0; x < (int) learnt.size(); ++x) {
+        int literal = learnt[x];
+        if (value(literal) == VALUE_TRUE || (x > 0 && literal == (learnt[x - 1] ^ 1))) {
+            return true;                         // satisfied or tautology
+        }
+        if (value(literal) != VALUE_FALSE && (kept == 0 || literal != learnt[kept - 1])) {
+            learnt[kept++] = literal;
+        }
+    }
+    learnt.resize(kept);
+
+    if (kept == 0) {
+        unsatisfiable = true;
+        return false;
+    }
+
+    if (kept == 1) {
+        enqueue(learnt[0], -1);
+        if (propagate() != -1) {
+            unsatisfiable = true;
+            return false;
+        }
+        return true;
+    }
+
+    attachClause(allocClause(learnt, false));
+    return true;
+}
+
+/**
+ * Searches for a satisfying assignment. Each restart period runs until luby(i) * 100
+ * conflicts; learnt clauses are thinned whenever they outnumber the current limit.
+ *
+ * @param conflict_budget (give up with UNKNOWN after this many conflicts, 0 = no limit)
+ * @return SATISFIABLE, UNSATISFIABLE or UNKNOWN
+ */
+CdclSolver::Result CdclSolver::solve(unsigned long long conflict_budget) {
+    if (unsatisfiable || propagate() != -1) {
+        unsatisfiable = true;
+        return UNSATISFIABLE;
+    }
+
+    double max_learnts = std::max(2000.0, (double) arena.size() / (HEADER + 2) / 3);
+    int restart_index = 0;
+
+    while (true) {
+        unsigned long long restart_limit = (unsigned long long) (luby(restart_index++) * 100);
+        unsigned long long period_conflicts = 0;
+
+        while (true) {
+            int conflict = propagate();
+
+            if (conflict != -1) {
+                ++stats.conflicts;
+                ++period_conflicts;
+
+                if (decisionLevel() == 0) {
+                    unsatisfiable = true;
+                    return UNSATISFIABLE;
+                }
+
+                int backtrack_level = 0;
+                int lbd = 0;
+                analyze(conflict, backtrack_level, lbd);
+                cancelUntil(backtrack_level);
+
+                if (learnt.size() == 1) {
+                    enqueue(learnt[0], -1);
+                } else {
+                    int clause = allocClause(learnt, true);
+                    arena[clause + 2] = lbd;
+                    learnts.push_back(clause);
+                    attachClause(clause);
+                    bumpClause(clause);
+                    enqueue(learnt[0], clause);
+                    ++stats.learnt_clauses;
+                }
+
+                var_inc *= 1 / 0.95;
+                clause_inc *= 1 / 0.999f;
+
+                if ((stats.conflicts & 0xff) == 0 && cancel_flag &&
+                    cancel_flag->load(std::memory_order_relaxed)) {
+                    cancelUntil(0);
+                    return UNKNOWN;
+                }
+                if (conflict_budget != 0 && stats.conflicts >= conflict_budget) {
+                    cancelUntil(0);
+                    return UNKNOWN;
+                }
+                continue;
+            }
+
+            if (period_conflicts >= restart_limit) {      // restart
+                ++stats.restarts;
+                cancelUntil(0);
+                break;
+            }
+
+            if ((double) learnts.size() - trail.size() >= max_learnts) {
+                reduceLearnts();
+                max_learnts *= 1.1;
+            }
+
+            int next = pickBranchLiteral();
+            if (next == -1) {                    // every variable assigned: model found
+                model.assign(assigns.begin(), assigns.end());
+                cancelUntil(0);
+                return SATISFIABLE;
+            }
+
+            ++stats.decisions;
+            trail_lim.push_back((int) trail.size());
+            enqueue(next, -1);
+        }
+    }
+}
+
+/**
+ * @return value of var in the satisfying assignment found by the last solve
+ */
+bool CdclSolver::modelValue(int var) const {
+    return var < (int) model.size() && model[var] == VALUE_TRUE;
+}
+
+/**
+ * Registers a flag that aborts the search once it becomes true
+ *
+ * @param flag (shared flag, or nullptr to run uncancellable)
+ */
+void CdclSolver::setCancelFlag(const std::atomic<bool> *flag) {
+    cancel_flag = flag;
+}
+
+/**
+ * @return counters of the last solve
+ */
+const CdclSolver::Stats &CdclSolver::getStats() const {
+    return stats;
+}
+
+uint8_t CdclSolver::value(int literal) const {
+    uint8_t val = assigns[literal >> 1];
+    return val == VALUE_UNDEF ? VALUE_UNDEF : (uint8_t) (val ^ (literal & 1));
+}
+
+int CdclSolver::decisionLevel() const {
+    return (int) trail_lim.size();
+}
+
+int CdclSolver::clauseSize(int clause) const {
+    return arena[clause];
+}
+
+int *CdclSolver::clauseLits(int clause) {
+    return &arena[clause + HEADER];
+}
+
+float CdclSolver::clauseActivity(int clause) const {
+    float score;
+    std::memcpy(&score, &arena[clause + 3], sizeof(score));
+    return score;
+}
+
+void CdclSolver::setClauseActivity(int clause, float score) {
+    std::memcpy(&arena[clause + 3], &score, sizeof(score));
+}
+
+/**
+ * Copies a clause into the arena
+ *
+ * @return arena offset of the clause
+ */
+int CdclSolver::allocClause(const std::vector<int> &lits, bool is_learnt) {
+    int clause = (int) arena.size();
+    float no_activity = 0.0f;
+    int activity_bits = 0;
+    std::memcpy(&activity_bits, &no_activity, sizeof(activity_bits));
+
+    arena.push_back((int) lits.size());
+    arena.push_back(is_learnt ? LEARNT : 0);
+    arena.push_back(0);
+    arena.push_back(activity_bits);
+    arena.insert(arena.end(), lits.begin(), lits.end());
+    return clause;
+}
+
+/**
+ * Watches the first two literals of a clause
+ */
+void CdclSolver::attachClause(int clause) {
+    int *lits = clauseLits(clause);
+    Watcher first = {clause, lits[1]};
+    Watcher second = {clause, lits[0]};
+
+    watches[lits[0]].push_back(first);
+    watches[lits[1]].push_back(second);
+}
+
+/**
+ * Makes a literal true at the current level
+ *
+ * @param from (clause that implied it, -1 for decisions and level-0 units)
+ */
+void CdclSolver::enqueue(int literal, int from) {
+    int var = literal >> 1;
+
+    assigns[var] = (uint8_t) ((literal & 1) ? VALUE_FALSE : VALUE_TRUE);
+    level[var] = decisionLevel();
+    reason[var] = from;
+    trail.push_back(literal);
+}
+
+/**
+ * Propagates every queued assignment through the watch lists
+ *
+ * @return conflicting clause, or -1 if there is none
+ */
+int CdclSolver::propagate() {
+    int conflict = -1;
+
+    while (qhead < (int) trail.size() && conflict == -1) {
+        int false_lit = trail[qhead++] ^ 1;
+        std::vector<Watcher> &ws = watches[false_lit];
+        std::size_t i = 0;
+        std::size_t j = 0;
+        ++stats.propagations;
+
+        while (i < ws.size()) {
+            Watcher w = ws[i];
+
+            if (value(w.blocker) == VALUE_TRUE) {
+                ws[j++] = ws[i++];
+                continue;
+            }
+            if (arena[w.clause + 1] & DELETED) {   // drop watchers of deleted clauses
+                ++i;
+                continue;
+            }
+
+            int *lits = clauseLits(w.clause);
+            int size = clauseSize(w.clause);
+            if (lits[0] == false_lit) {          // keeps the false literal at lits[1]
+                lits[0] = lits[1];
+                lits[1] = false_lit;
+            }
+            ++i;
+
+            int first = lits[0];
+            Watcher moved = {w.clause, first};
+            if (first != w.blocker && value(first) == VALUE_TRUE) {
+                ws[j++] = moved;
+                continue;
+            }
+
+            bool found = false;
+            for (int k = 2; k < size; ++k) {     // looks for a new literal to watch
+                if (value(lits[k]) != VALUE_FALSE) {
+                    lits[1] = lits[k];
+                    lits[k] = false_lit;
+                    watches[lits[1]].push_back(moved);
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                continue;
+            }
+
+            ws[j++] = moved;
+            if (value(first) == VALUE_FALSE) {   // every literal false: conflict
+                conflict = w.clause;
+                while (i < ws.size()) {
+                    ws[j++] = ws[i++];
+                }
+            } else {                             // unit: first is implied
+                enqueue(first, w.clause);
+            }
+        }
+
+        ws.resize(j);
+    }
+
+    if (conflict != -1) {
+        qhead = (int) trail.size();
+    }
+    return conflict;
+}
+
+/**
+ * First-UIP conflict analysis. Leaves the learnt clause in learnt, with the asserting
+ * literal first and a literal of the backtrack level second.
+ *
+ * @param conflict (conflicting clause)
+ * @param backtrack_level (filled with the level to backjump to)
+ * @param lbd (filled with the number of distinct levels in the learnt clause)
+ */
+void CdclSolver::analyze(int conflict, int &backtrack_level, int &lbd) {
+    int path_count = 0;
+    int literal = -1;
+    int index = (int) trail.size() - 1;
+
+    learnt.clear();
+    learnt.push_back(-1);                        // room for the asserting literal
+
+    do {
+        if (arena[conflict + 1] & LEARNT) {
+            bumpClause(conflict);
+        }
+
+        int *lits = clauseLits(conflict);
+        for (int x = literal == -1 ? 0 : 1; x < clauseSize(conflict); ++x) {
+            int var = lits[x] >> 1;
+            if (!seen[var] && level[var] > 0) {
+                bumpVar(var);
+                seen[var] = 1;
+                if (level[var] >= decisionLevel()) {
+                    ++path_count;
+                } else {
+                    learnt.push_back(lits[x]);
+                }
+            }
+        }
+
+        while (!seen[trail[index--] >> 1]) {
+        }
+        literal = trail[index + 1];
+        conflict = reason[literal >> 1];
+        seen[literal >> 1] = 0;
+        --path_count;
+    } while (path_count > 0);
+
+    learnt[0] = literal ^ 1;
+
+    // drops literals implied by the rest of the clause
+    std::vector<int> marked(learnt.begin() + 1, learnt.end());
+    int kept = 1;
+    for (int x = 1; x < (int) learnt.size(); ++x) {
+        if (reason[learnt[x] >> 1] == -1 || !redundant(learnt[x])) {
+            learnt[kept++] = learnt[x];
+        }
+    }
+    learnt.resize(kept);
+    for (int literal_marked : marked) {
+        seen[literal_marked >> 1] = 0;
+    }
+
+    backtrack_level = 0;
+    if (learnt.size() > 1) {
+        int max_pos = 1;
+        for (int x = 2; x < (int) learnt.size(); ++x) {
+            if (level[learnt[x] >> 1] > level[learnt[max_pos] >> 1]) {
+                max_pos = x;
+            }
+        }
+        std::swap(learnt[1], learnt[max_pos]);
+        backtrack_level = level[learnt[1] >> 1];
+    }
+
+    std::vector<int> levels;
+    for (int x = 0; x < (int) learnt.size(); ++x) {
+        levels.push_back(level[learnt[x] >> 1]);
+    }
+    std::sort(levels.begin(), levels.end());
+    lbd = (int) (std::unique(levels.begin(), levels.end()) - levels.begin());
+}
+
+/**
+ * Local minimization: a literal is redundant if every other literal of its reason is
+ * already in the learnt clause or fixed at level 0
+ */
+bool CdclSolver::redundant(int literal) {
+    int clause = reason[literal >> 1];
+    int *lits = clauseLits(clause);
+
+    for (int x = 1; x < clauseSize(clause); ++x) {
+        int var = lits[x] >> 1;
+        if (!seen[var] && level[var] > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Undoes every assignment above the target level, saving their phases
+ */
+void CdclSolver::cancelUntil(int target_level) {
+    if (decisionLevel() <= target_level) {
+        return;
+    }
+
+    for (int x = (int) trail.size() - 1; x >= trail_lim[target_level]; --x) {
+        int var = trail[x] >> 1;
+        phase[var] = assigns[var];
+        assigns[var] = VALUE_UNDEF;
+        reason[var] = -1;
+        if (heap_index[var] == -1) {
+            heapInsert(var);
+        }
+    }
+
+    trail.resize(trail_lim[target_level]);
+    trail_lim.resize(target_level);
+    qhead = (int) trail.size();
+}
+
+/**
+ * @return unassigned variable with the highest activity in its saved phase, or -1 if
+ * every variable is assigned
+ */
+int CdclSolver::pickBranchLiteral() {
+    while (!heap.empty()) {
+        int var = heapPop();
+        if (assigns[var] == VALUE_UNDEF) {
+            return lit(var, phase[var] != VALUE_TRUE);
+        }
+    }
+    return -1;
+}
+
+/**
+ * Deletes half of the learnt clauses, keeping those with low LBD ("glue" clauses), high
+ * activity or currently acting as a reason
+ */
+void CdclSolver::reduceLearnts() {
+    std::sort(learnts.begin(), learnts.end(), [this](int a, int b) {
+        if (arena[a + 2] != arena[b + 2]) {
+            return arena[a + 2] > arena[b + 2];
+        }
+        return clauseActivity(a) < clauseActivity(b);
+    });
+
+    std::size_t kept = 0;
+    std::size_t limit = learnts.size() / 2;
+    for (std::size_t x = 0; x < learnts.size(); ++x) {
+        int clause = learnts[x];
+        if (x < limit && arena[clause + 2] > 2 && !locked(clause)) {
+            arena[clause + 1] |= DELETED;
+            wasted += HEADER + clauseSize(clause);
+            ++stats.deleted_clauses;
+        } else {
+            learnts[kept++] = clause;
+        }
+    }
+    learnts.resize(kept);
+
+    if (wasted > (int) arena.size() / 2) {
+        collectGarbage();
+    }
+}
+
+/**
+ * Compacts the arena once deleted clauses take up half of it, then rebuilds the watch
+ * lists and reasons to point at the moved clauses
+ */
+void CdclSolver::collectGarbage() {
+    std::vector<int> compacted;
+    std::vector<int> moved_to(arena.size(), -1);
+    compacted.reserve(arena.size() - wasted);
+
+    for (int clause = 0; clause < (int) arena.size(); clause += HEADER + arena[clause]) {
+        if (!(arena[clause + 1] & DELETED)) {
+            moved_to[clause] = (int) compacted.size();
+            compacted.insert(compacted.end(), arena.begin() + clause,
+                             arena.begin() + clause + HEADER + arena[clause]);
+        }
+    }
+
+    for (int var = 0; var < var_count; ++var) {
+        if (reason[var] != -1) {
+            reason[var] = moved_to[reason[var]];
+        }
+    }
+    for (int &clause : learnts) {
+        clause = moved_to[clause];
+    }
+
+    arena.swap(compacted);
+    wasted = 0;
+
+    for (std::vector<Watcher> &ws : watches) {
+        ws.clear();
+    }
+    for (int clause = 0; clause < (int) arena.size(); clause += HEADER + arena[clause]) {
+        attachClause(clause);
+    }
+}
+
+/**
+ * @return true if the clause is the reason of a current assignment
+ */
+bool CdclSolver::locked(int clause) {
+    int var = clauseLits(clause)[0] >> 1;
+    return reason[var] == clause && value(clauseLits(clause)[0]) == VALUE_TRUE;
+}
+
+void CdclSolver::bumpVar(int var) {
+    if ((activity[var] += var_inc) > 1e100) {    // rescales before overflow
+        for (double &score : activity) {
+            score *= 1e-100;
+        }
+        var_inc *= 1e-100;
+    }
+    if (heap_index[var] != -1) {
+        heapUp(heap_index[var]);
+    }
+}
+
+void CdclSolver::bumpClause(int clause) {
+    setClauseActivity(clause, clauseActivity(clause) + clause_inc);
+    if (clauseActivity(clause) > 1e20f) {
+        for (int learnt_clause : learnts) {
+            setClauseActivity(learnt_clause, clauseActivity(learnt_clause) * 1e-20f);
+        }
+        clause_inc *= 1e-20f;
+    }
+}
+
+void CdclSolver::heapInsert(int var) {
+    heap_index[var] = (int) heap.size();
+    heap.push_back(var);
+    heapUp((int) heap.size() - 1);
+}
+
+void CdclSolver::heapUp(int pos) {
+    int var = heap[pos];
+    while (pos > 0 && activity[heap[(pos - 1) / 2]] < activity[var]) {
+        heap[pos] = heap[(pos - 1) / 2];
+        heap_index[heap[pos]] = pos;
+        pos = (pos - 1) / 2;
+    }
+    heap[pos] = var;
+    heap_index[var] = pos;
+}
+
+void CdclSolver::heapDown(int pos) {
+    int var = heap[pos];
+    int size = (int) heap.size();
+    while (2 * pos + 1 < size) {
+        int child = 2 * pos + 1;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) {
+            ++child;
+        }
+        if (activity[heap[child]] <= activity[var]) {
+            break;
+        }
+        heap[pos] = heap[child];
+        heap_index[heap[pos]] = pos;
+        pos = child;
+    }
+    heap[pos] = var;
+    heap_index[var] = pos;
+}
+
+int CdclSolver::heapPop() {
+    int top = heap[0];
+    heap[0] = heap.back();
+    heap_index[heap[0]] = 0;
+    heap.pop_back();
+    heap_index[top] = -1;
+    if (!heap.empty()) {
+        heapDown(0);
+    }
+    return top;
+}
+
+/**
+ * @return i-th element (0-based) of the Luby restart sequence 1 1 2 1 1 2 4 ...
+ */
+double CdclSolver::luby(int i) {
+    int size = 1;
+    int seq = 0;
+    while (size < i + 1) {
+        ++seq;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+        size = (size - 1) >> 1;
+        --seq;
+        i = i % size;
+    }
+    return std::pow(2.0, seq);
+}
@@ -0,0 +1,168 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef CDCL_SOLVER_H
+#define CDCL_SOLVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Self-contained conflict-driven clause-learning SAT solver: two watched literals per
+ * clause, first-UIP learning with clause minimization, VSIDS branching with phase saving,
+ * Luby restarts and LBD-based deletion of learnt clauses.
+ *
+ * Variables are numbered from 0; a literal is 2 * var for the positive form and
+ * 2 * var + 1 for the negated form (see lit()).
+ */
+class CdclSolver {
+
+public:
+    enum Result {
+        SATISFIABLE,
+        UNSATISFIABLE,
+        UNKNOWN         // cancelled or out of conflict budget
+    };
+
+    /**
+     * Counters of the last solve
+     */
+    struct Stats {
+        unsigned long long decisions;
+        unsigned long long propagations;
+        unsigned long long conflicts;
+        unsigned long long restarts;
+        unsigned long long learnt_clauses;
+        unsigned long long deleted_clauses;
+    };
+
+    CdclSolver();
+
+    /**
+    * @return literal of var, negated if negative is true
+    */
+    static int lit(int var, bool negative = false) {
+        return 2 * var + (negative ? 1 : 0);
+    }
+
+    /**
+    * Clears every clause and sets the number of variables
+    */
+    void reset(int var_count);
+
+    /**
+    * Adds a problem clause. Clauses may be added only before solve.
+    *
+    * @param lits (literals of the clause; duplicates and tautologies are handled)
+    * @return false if the formula is now known to be unsatisfiable
+    */
+    bool addClause(const std::vector<int> &lits);
+
+    /**
+    * Searches for a satisfying assignment.
+    *
+    * @param conflict_budget (give up with UNKNOWN after this many conflicts, 0 = no limit)
+    * @return SATISFIABLE, UNSATISFIABLE or UNKNOWN
+    */
+    Result solve(unsigned long long conflict_budget = 0);
+
+    /**
+    * @return value of var in the satisfying assignment found by the last solve
+    */
+    bool modelValue(int var) const;
+
+    /**
+    * Registers a flag that aborts the search once it becomes true
+    *
+    * @param flag (shared flag, or nullptr to run uncancellable)
+    */
+    void setCancelFlag(const std::atomic<bool> *flag);
+
+    /**
+    * @return counters of the last solve
+    */
+    const Stats &getStats() const;
+
+private:
+    static const uint8_t VALUE_FALSE = 0;
+    static const uint8_t VALUE_TRUE = 1;
+    static const uint8_t VALUE_UNDEF = 2;
+
+    // clause header layout in the arena: size, flags, lbd, activity (float bits)
+    static const int HEADER = 4;
+    static const int LEARNT = 1;
+    static const int DELETED = 2;
+
+    /**
+     * Entry of a literal's watch list: the clause, plus a literal of it that is checked
+     * first since a true blocker means the clause needs no visit
+     */
+    struct Watcher {
+        int clause;
+        int blocker;
+    };
+
+    int var_count;
+    bool unsatisfiable;                    // a conflict was derived at level 0
+    const std::atomic<bool> *cancel_flag;  // polled during search, may be nullptr
+    Stats stats;
+
+    std::vector<int> arena;                // every clause, header then literals
+    std::vector<int> learnts;              // arena offsets of the learnt clauses
+    int wasted;                            // arena ints held by deleted clauses
+
+    std::vector<std::vector<Watcher>> watches;  // per literal, visited when it turns false
+    std::vector<uint8_t> assigns;          // value of each variable
+    std::vector<uint8_t> phase;            // last value of each variable (phase saving)
+    std::vector<int> level;                // decision level of each assigned variable
+    std::vector<int> reason;               // implying clause of each variable, -1 if none
+    std::vector<int> trail;                // assigned literals in order
+    std::vector<int> trail_lim;            // trail length at the start of each level
+    int qhead;                             // next trail entry to propagate
+
+    std::vector<double> activity;          // VSIDS score of each variable
+    double var_inc;
+    float clause_inc;
+    std::vector<int> heap;                 // variables ordered by activity (max-heap)
+    std::vector<int> heap_index;           // position of each variable in heap, -1 if absent
+
+    std::vector<uint8_t> seen;             // scratch marks for analyze
+    std::vector<int> learnt;               // scratch learnt clause
+    std::vector<int> model;                // satisfying assignment of the last solve
+
+    uint8_t value(int literal) const;
+    int decisionLevel() const;
+    int clauseSize(int clause) const;
+    int *clauseLits(int clause);
+    float clauseActivity(int clause) const;
+    void setClauseActivity(int clause, float score);
+
+    int allocClause(const std::vector<int> &lits, bool is_learnt);
+    void attachClause(int clause);
+    void enqueue(int literal, int from);
+    int propagate();
+    void analyze(int conflict, int &backtrack_level, int &lbd);
+    bool redundant(int literal);
+    void cancelUntil(int target_level);
+    int pickBranchLiteral();
+    void reduceLearnts();
+    void collectGarbage();
+    bool locked(int clause);
+
+    void bumpVar(int var);
+    void bumpClause(int clause);
+    void heapInsert(int var);
+    void heapUp(int pos);
+    void heapDown(int pos);
+    int heapPop();
+
+    /**
+    * @return i-th element (0-based) of the Luby restart sequence 1 1 2 1 1 2 4 ...
+    */
+    static double luby(int i);
+};
+
+#endif // ends CDCL_SOLVER_H
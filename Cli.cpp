@@ -0,0 +1,525 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "Cli.h"
+#include "BandCounter.h"
+#include "Generator.h"
+#include "GridFormat.h"
+#include "Job.h"
+#include "Pipeline.h"
+#include "SolverContext.h"
+#include "Validator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::size_t CHUNK_GRIDS = 1 << 16;   // grids validated per batch call
+
+/**
+ * Prints the commands to stderr
+ */
+void usage(const char *program) {
+    fprintf(stderr, "usage: %s validate [--packed] [--side n] [file]\n"
+                    "       %s solve [--pretty | --packed] [--side n] [--threads n] "
+                    "[--pin none|node|core] [file]\n"
+                    "       %s job [--pretty | --packed] [--side n] [--threads n] "
+                    "[--shard-bytes n] input directory\n"
+                    "       %s trace [--side n] file trace-file\n"
+                    "       %s bench [--side n] [--count n] [--holes f] [--seed n]\n"
+                    "       %s count [--box rxc] [file]\n",
+            program, program, program, program, program, program);
+}
+
+/**
+ * Prints the tail of a run's solve times (in microseconds) and node counts to stderr
+ */
+void printProfile(const SolveProfile &profile) {
+    const double percents[] = {50, 90, 99, 99.9};
+    if (profile.latency.getCount() == 0) {
+        return;
+    }
+
+    fprintf(stderr, "latency us:");
+    for (double percent : percents) {
+        fprintf(stderr, " p%g %.1f", percent, profile.latency.valueAt(percent) / 1000.0);
+    }
+    fprintf(stderr, " max %.1f\nnodes:", profile.latency.getMax() / 1000.0);
+    for (double percent : percents) {
+        fprintf(stderr, " p%g %llu", percent,
+                (unsigned long long) profile.nodes.valueAt(percent));
+    }
+    fprintf(stderr, " max %llu\n", (unsigned long long) profile.nodes.getMax());
+}
+
+/**
+ * Totals of a validate run
+ */
+struct ValidateCounts {
+    unsigned long long complete;
+    unsigned long long partial;
+    unsigned long long invalid;
+};
+
+/**
+ * Validates a chunk of same-size grids, reports the invalid ones and empties the chunk
+ *
+ * @param indices (input index of each grid in the chunk)
+ */
+void flushChunk(std::vector<uint8_t> &grids, std::vector<unsigned long long> &indices,
+                int side_length, std::vector<GridStatus> &statuses, ValidateCounts &counts) {
+    if (indices.empty()) {
+        return;
+    }
+
+    statuses.resize(indices.size());
+    validateBatch(grids.data(), statuses.data(), indices.size(), side_length);
+
+    for (std::size_t x = 0; x < indices.size(); ++x) {
+        if (statuses[x] == GridStatus::INVALID) {
+            printf("%llu: invalid\n", indices[x]);
+            ++counts.invalid;
+        } else if (statuses[x] == GridStatus::PARTIAL) {
+            ++counts.partial;
+        } else {
+            ++counts.complete;
+        }
+    }
+
+    grids.clear();
+    indices.clear();
+}
+
+/**
+ * validate command: streams grids through validateBatch in large chunks
+ */
+int validate(int argc, char *argv[]) {
+    bool packed = false;
+    int side_length = 9;
+    const char *path = nullptr;
+
+    for (int x = 2; x < argc; ++x) {
+        if (std::strcmp(argv[x], "--packed") == 0) {
+            packed = true;
+        } else if (std::strcmp(argv[x], "--side") == 0 && x + 1 < argc) {
+            side_length = std::atoi(argv[++x]);
+        } else if (!path) {
+            path = argv[x];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *file = path ? fopen(path, "rb") : stdin;
+    if (!file || side_length <= 0 || side_length > 64) {
+        fprintf(stderr, "Unable to open file!\n");
+        return 2;
+    }
+
+    ValidateCounts counts = {0, 0, 0};
+    std::vector<uint8_t> grids;
+    std::vector<unsigned long long> indices;
+    std::vector<GridStatus> statuses;
+    unsigned long long index = 0;
+
+    if (packed) {
+        std::size_t cells = (std::size_t) side_length * side_length;
+        grids.resize(CHUNK_GRIDS * cells);
+
+        std::size_t got;
+        while ((got = fread(grids.data(), cells, CHUNK_GRIDS, file)) > 0) {
+            grids.resize(got * cells);
+            for (std::size_t x = 0; x < got; ++x) {
+                indices.push_back(index++);
+            }
+            flushChunk(grids, indices, side_length, statuses, counts);
+            grids.resize(CHUNK_GRIDS * cells);
+        }
+    } else {
+        // lines are grouped into chunks of one board size; a new size starts a new chunk
+        LineReader reader(file);
+        const char *line;
+        std::size_t length;
+        int chunk_side = 0;
+
+        while (reader.next(line, length)) {
+            std::size_t size = grids.size();
+            grids.resize(size + length);
+
+            int line_side = parseLine(line, length, grids.data() + size);
+            if (line_side == 0) {
+                grids.resize(size);
+                if (length != 0 && !(length == 1 && line[0] == '\r')) {
+                    printf("%llu: malformed\n", index);
+                    ++counts.invalid;
+                    ++index;
+                }
+                continue;
+            }
+            grids.resize(size + (std::size_t) line_side * line_side);
+
+            if (line_side != chunk_side || indices.size() == CHUNK_GRIDS) {
+                std::vector<uint8_t> last(grids.end() - (std::ptrdiff_t) line_side * line_side,
+                                          grids.end());
+                grids.resize(size);
+                flushChunk(grids, indices, chunk_side, statuses, counts);
+                grids = last;
+                chunk_side = line_side;
+            }
+            indices.push_back(index++);
+        }
+        flushChunk(grids, indices, chunk_side, statuses, counts);
+    }
+
+    if (path) {
+        fclose(file);
+    }
+
+    printf("%llu grids: %llu complete, %llu partial, %llu invalid\n", index, counts.complete,
+           counts.partial, counts.invalid);
+    return counts.invalid == 0 ? 0 : 1;
+}
+
+/**
+ * solve command: streams puzzles through runPipeline, so reading, solving and writing
+ * overlap and memory stays flat however large the input is
+ */
+int solve(int argc, char *argv[]) {
+    PipelineConfig config;
+    const char *path = nullptr;
+
+    for (int x = 2; x < argc; ++x) {
+        if (std::strcmp(argv[x], "--threads") == 0 && x + 1 < argc) {
+            config.thread_count = std::atoi(argv[++x]);
+        } else if (std::strcmp(argv[x], "--pin") == 0 && x + 1 < argc) {
+            std::string pinning = argv[++x];
+            config.pinning = pinning == "none" ? Pinning::NONE :
+                             pinning == "core" ? Pinning::CORE : Pinning::NODE;
+        } else if (std::strcmp(argv[x], "--pretty") == 0) {
+            config.style = GridStyle::PRETTY;
+        } else if (std::strcmp(argv[x], "--packed") == 0) {
+            config.style = GridStyle::PACKED;
+        } else if (std::strcmp(argv[x], "--side") == 0 && x + 1 < argc) {
+            config.side_length = std::atoi(argv[++x]);
+        } else if (!path) {
+            path = argv[x];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *file = path ? fopen(path, "rb") : stdin;
+    if (!file || config.side_length <= 0 || config.side_length > 64) {
+        fprintf(stderr, "Unable to open file!\n");
+        return 2;
+    }
+
+    config.report = stderr;
+    PipelineStats stats;
+    bool written = runPipeline(file, stdout, config, stats);
+
+    if (path) {
+        fclose(file);
+    }
+    if (!written) {
+        fprintf(stderr, "Unable to write the solutions!\n");
+        return 2;
+    }
+
+    fprintf(stderr, "%llu puzzles: %llu solved, %llu unsolved, %llu malformed\n", stats.lines,
+            stats.solved, stats.puzzles - stats.solved, stats.malformed);
+    printProfile(stats.profile);
+    return stats.solved == stats.lines ? 0 : 1;
+}
+
+/**
+ * job command: solves a corpus in resumable shards, see runJob
+ */
+int job(int argc, char *argv[]) {
+    JobConfig config;
+    std::vector<const char *> paths;
+
+    for (int x = 2; x < argc; ++x) {
+        if (std::strcmp(argv[x], "--pretty") == 0) {
+            config.style = GridStyle::PRETTY;
+        } else if (std::strcmp(argv[x], "--packed") == 0) {
+            config.style = GridStyle::PACKED;
+        } else if (std::strcmp(argv[x], "--side") == 0 && x + 1 < argc) {
+            config.side_length = std::atoi(argv[++x]);
+        } else if (std::strcmp(argv[x], "--threads") == 0 && x + 1 < argc) {
+            config.thread_count = std::atoi(argv[++x]);
+        } else if (std::strcmp(argv[x], "--shard-bytes") == 0 && x + 1 < argc) {
+            config.shard_bytes = (std::size_t) std::strtoull(argv[++x], nullptr, 10);
+        } else {
+            paths.push_back(argv[x]);
+        }
+    }
+
+    if (paths.size() != 2) {
+        usage(argv[0]);
+        return 2;
+    }
+    config.input = paths[0];
+    config.directory = paths[1];
+
+    JobSummary summary;
+    std::string error;
+    if (!runJob(config, summary, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+
+    fprintf(stderr, "%zu shards: %zu solved here, %zu already done, %zu busy elsewhere\n"
+                    "%llu puzzles: %llu solved, %llu unsolved, %llu malformed\n",
+            summary.shards, summary.completed, summary.skipped, summary.busy, summary.puzzles,
+            summary.solved, summary.puzzles - summary.solved, summary.malformed);
+    printProfile(summary.profile);
+    return summary.busy == 0 && summary.solved == summary.puzzles && summary.malformed == 0 ?
+           0 : 1;
+}
+
+/**
+ * trace command: solves the first puzzle of a file with a BinaryTracer and writes the
+ * trace, for offline analysis of a puzzle that explodes
+ */
+int trace(int argc, char *argv[]) {
+    int side_length = 9;
+    std::vector<const char *> paths;
+
+    for (int x = 2; x < argc; ++x) {
+        if (std::strcmp(argv[x], "--side") == 0 && x + 1 < argc) {
+            side_length = std::atoi(argv[++x]);
+        } else {
+            paths.push_back(argv[x]);
+        }
+    }
+
+    if (paths.size() != 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE *file = fopen(paths[0], "rb");
+    if (!file || side_length <= 0 || side_length > 64) {
+        fprintf(stderr, "Unable to open file!\n");
+        return 2;
+    }
+
+    std::vector<uint8_t> puzzle;
+    {
+        LineReader reader(file);
+        const char *line;
+        std::size_t length;
+
+        while (puzzle.empty() && reader.next(line, length)) {
+            puzzle.resize(length);
+            if (parseLine(line, length, puzzle.data()) != side_length) {
+                puzzle.clear();
+            }
+        }
+    }
+    fclose(file);
+
+    FILE *output = fopen(paths[1], "wb");
+    if (puzzle.empty() || !output) {
+        fprintf(stderr, puzzle.empty() ? "No puzzle found!\n" : "Unable to open file!\n");
+        if (output) {
+            fclose(output);
+        }
+        return 2;
+    }
+
+    SolverPool::Lease context = SolverPool::acquire();
+    BinaryTracer tracer(output);
+    bool solved = context->arm(puzzle.data(), side_length) &&
+                  context->solve(SearchOptions(), tracer);
+    bool written = tracer.flush();
+    written &= fclose(output) == 0;
+
+    const SearchStats &stats = context->getStats();
+    fprintf(stderr, "%s: %llu nodes, %llu backtracks, %llu trace records\n",
+            solved ? "solved" : "no solution", stats.nodes, stats.backtracks,
+            tracer.getRecordCount());
+    return written ? (solved ? 0 : 1) : 2;
+}
+
+/**
+ * bench command: solves generated puzzles of each giant size (or of one size) and
+ * reports how many were solved and the latency and node percentiles per size
+ */
+int bench(int argc, char *argv[]) {
+    std::vector<int> sides;
+    int count = 20;
+    double holes = 0.35;
+    uint64_t seed = 1;
+
+    for (int x = 2; x < argc; ++x) {
+        if (std::strcmp(argv[x], "--side") == 0 && x + 1 < argc) {
+            sides.push_back(std::atoi(argv[++x]));
+        } else if (std::strcmp(argv[x], "--count") == 0 && x + 1 < argc) {
+            count = std::atoi(argv[++x]);
+        } else if (std::strcmp(argv[x], "--holes") == 0 && x + 1 < argc) {
+            holes = std::atof(argv[++x]);
+        } else if (std::strcmp(argv[x], "--seed") == 0 && x + 1 < argc) {
+            seed = std::strtoull(argv[++x], nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (sides.empty()) {
+        sides = {36, 49, 64};
+    }
+
+    SolverPool::Lease context = SolverPool::acquire();
+    SearchRandom random(seed);
+    bool all_solved = true;
+
+    for (int side_length : sides) {
+        int box_size = 1;
+        while (box_size * box_size < side_length) {
+            ++box_size;
+        }
+        if (side_length <= 0 || side_length > 64 || box_size * box_size != side_length) {
+            usage(argv[0]);
+            return 2;
+        }
+
+        std::size_t cells = (std::size_t) side_length * side_length;
+        std::vector<uint8_t> puzzle(cells);
+        std::vector<uint8_t> solution(cells);
+        SolveProfile profile;
+        int solved = 0;
+
+        for (int x = 0; x < count; ++x) {
+            generatePuzzle(side_length, holes, random, puzzle.data());
+            solved += solveOne(*context, puzzle.data(), side_length, solution.data(),
+                               &profile) &&
+                      validateGrid(solution.data(), side_length) == GridStatus::COMPLETE;
+        }
+
+        fprintf(stderr, "%d x %d: %d of %d solved\n", side_length, side_length, solved,
+                count);
+        printProfile(profile);
+        all_solved &= solved == count;
+    }
+
+    return all_solved ? 0 : 1;
+}
+
+/**
+ * count command: prints the exact number of completions of every board read, counted
+ * by a BandCounter instead of by enumerating them
+ */
+int count(int argc, char *argv[]) {
+    int box_rows = 0;
+    int box_cols = 0;
+    const char *path = nullptr;
+
+    for (int x = 2; x < argc; ++x) {
+        if (std::strcmp(argv[x], "--box") == 0 && x + 1 < argc) {
+            if (sscanf(argv[++x], "%dx%d", &box_rows, &box_cols) != 2 || box_rows <= 0 ||
+                box_cols <= 0) {
+                usage(argv[0]);
+                return 2;
+            }
+        } else if (!path) {
+            path = argv[x];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *file = path ? fopen(path, "rb") : stdin;
+    if (!file) {
+        fprintf(stderr, "Unable to open file!\n");
+        return 2;
+    }
+
+    LineReader reader(file);
+    const char *line;
+    std::size_t length;
+    std::vector<uint8_t> cells;
+    unsigned long long index = 0;
+    bool all_counted = true;
+
+    while (reader.next(line, length)) {
+        if (length == 0 || (length == 1 && line[0] == '\r')) {
+            continue;
+        }
+        cells.resize(length);
+        int side_length = parseLine(line, length, cells.data());
+
+        // without --box, the squarest boxes that fit: 3 x 3 for 9, 2 x 3 for 6
+        int rows = box_rows;
+        int cols = box_cols;
+        if (rows == 0) {
+            for (int divisor = 1; divisor * divisor <= side_length; ++divisor) {
+                if (side_length % divisor == 0) {
+                    rows = divisor;
+                }
+            }
+            cols = rows > 0 ? side_length / rows : 0;
+        }
+
+        CompletionCount completions;
+        if (side_length == 0) {
+            printf("%llu: malformed\n", index);
+            all_counted = false;
+        } else if (rows * cols != side_length || !BandCounter(rows, cols).count(
+                       cells.data(), completions)) {
+            printf("%llu: unsupported\n", index);
+            all_counted = false;
+        } else {
+            printf("%llu: %s\n", index, completions.toString().c_str());
+        }
+        ++index;
+    }
+
+    if (path) {
+        fclose(file);
+    }
+    return all_counted ? 0 : 1;
+}
+
+} // namespace
+
+/**
+ * Runs a command-line tool instead of the test driver
+ *
+ * @param argc, argv (arguments of main, argv[1] being the command)
+ * @return process exit code: 0 on success, 1 if a grid failed, 2 on bad usage
+ */
+int runCli(int argc, char *argv[]) {
+    std::string command = argc > 1 ? argv[1] : "";
+
+    if (command == "validate") {
+        return validate(argc, argv);
+    }
+    if (command == "solve") {
+        return solve(argc, argv);
+    }
+    if (command == "job") {
+        return job(argc, argv);
+    }
+    if (command == "trace") {
+        return trace(argc, argv);
+    }
+    if (command == "bench") {
+        return bench(argc, argv);
+    }
+    if (command == "count") {
+        return count(argc, argv);
+    }
+
+    usage(argv[0]);
+    return 2;
+}
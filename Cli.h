@@ -0,0 +1,44 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef CLI_H
+#define CLI_H
+
+/**
+ * Runs a command-line tool instead of the test driver. Commands:
+ *
+ *   validate [--packed] [--side n] [file]
+ *       checks one grid per line (or, with --packed, raw n * n byte records) read from
+ *       file or stdin; prints the index of every invalid grid and a summary
+ *
+ *   solve [--pretty | --packed] [--side n] [--threads n] [--pin none|node|core] [file]
+ *       solves one puzzle per line read from file or stdin through runPipeline and writes
+ *       each solution (or the givens of an unsolvable puzzle) as a line, a pretty grid
+ *       or packed bytes, then the latency and node percentiles of the run
+ *
+ *   job [--pretty | --packed] [--side n] [--threads n] [--shard-bytes n] input directory
+ *       solves the input corpus in shards, writing directory/shard-k.out per shard;
+ *       rerunning resumes after the last completed shard, and several processes can
+ *       share one directory (see runJob)
+ *
+ *   trace [--side n] file trace-file
+ *       solves the first puzzle of file with a BinaryTracer and writes its search trace
+ *
+ *   bench [--side n] [--count n] [--holes f] [--seed n]
+ *       solves count generated puzzles (default 20) of each given side, or of 36 x 36,
+ *       49 x 49 and 64 x 64, with the fraction holes of their squares emptied (default
+ *       0.35), and prints the latency and node percentiles per size
+ *
+ *   count [--box rxc] [file]
+ *       prints the exact number of completions of every board read from file or stdin,
+ *       with r x c boxes (default: the squarest boxes that fit, 2 x 3 for 6 x 6); counts
+ *       past 2^128, or boards over 16 x 16, are reported unsupported
+ *
+ * @param argc, argv (arguments of main, argv[1] being the command)
+ * @return process exit code: 0 on success, 1 if a grid failed, 2 on bad usage
+ */
+int runCli(int argc, char *argv[]);
+
+#endif // ends CLI_H
@@ -0,0 +1,270 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "DancingLinks.h"
+#include <cmath>
+#include <cstring>
+
+/**
+ * constructs an empty solver; the matrix is built on the first call to arm
+ */
+DancingLinks::DancingLinks()
+        : side_length(0), box_size(0), column_count(0), armed(false), cancelled(false),
+          node_count(0), cancel_flag(nullptr) {
+}
+
+/**
+ * Builds the exact-cover matrix for a puzzle. Values already ruled out by the givens
+ * are left out of the matrix, which keeps it small on well-filled boards.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board, must be a square number)
+ * @return false if the puzzle is malformed
+ */
+bool DancingLinks::arm(const uint8_t *cells, int new_side_length) {
+    armed = false;
+    node_count = 0;
+
+    box_size = (int) (sqrt(new_side_length));
+    if (new_side_length <= 0 || new_side_length > 32 || box_size * box_size != new_side_length) {
+        return false;
+    }
+
+    side_length = new_side_length;
+    int cell_count = side_length * side_length;
+    column_count = 4 * cell_count;
+
+    board.assign(cells, cells + cell_count);
+    solution.clear();
+
+    // clear keeps capacity, so re-arming with the same size does not allocate
+    left.clear();
+    right.clear();
+    up.clear();
+    down.clear();
+    column.clear();
+    node_choice.clear();
+    column_size.assign(column_count + 1, 0);
+
+    for (int col = 0; col <= column_count; ++col) {  // root (0) and column headers
+        left.push_back(col == 0 ? column_count : col - 1);
+        right.push_back(col == column_count ? 0 : col + 1);
+        up.push_back(col);
+        down.push_back(col);
+        column.push_back(col);
+        node_choice.push_back(-1);
+    }
+
+    // values used per row/col/box by the givens, to leave impossible rows out
+    std::vector<uint32_t> used(3 * side_length, 0);
+    for (int cell = 0; cell < cell_count; ++cell) {
+        if (board[cell] > side_length) {
+            return false;
+        }
+        if (board[cell] != 0) {
+            int row_number = cell / side_length;
+            int col_number = cell % side_length;
+            int box_number = (row_number / box_size) * box_size + col_number / box_size;
+            uint32_t bit = 1u << (board[cell] - 1);
+
+            used[row_number] |= bit;
+            used[side_length + col_number] |= bit;
+            used[2 * side_length + box_number] |= bit;
+        }
+    }
+
+    for (int cell = 0; cell < cell_count; ++cell) {
+        if (board[cell] != 0) {
+            addRow(cell, board[cell]);
+            continue;
+        }
+
+        int row_number = cell / side_length;
+        int col_number = cell % side_length;
+        int box_number = (row_number / box_size) * box_size + col_number / box_size;
+        uint32_t taken = used[row_number] | used[side_length + col_number] |
+                         used[2 * side_length + box_number];
+
+        for (int val = 1; val <= side_length; ++val) {
+            if (!(taken & (1u << (val - 1)))) {
+                addRow(cell, val);
+            }
+        }
+    }
+
+    armed = true;
+    return true;
+}
+
+/**
+ * Searches for an exact cover, i.e. a complete board
+ *
+ * @return true if a solution exists, false if not or if the search was cancelled
+ */
+bool DancingLinks::solve() {
+    cancelled = false;
+
+    if (!armed || !search()) {
+        return false;
+    }
+
+    for (int node : solution) {
+        int choice = node_choice[node];
+        board[choice / side_length] = (uint8_t) (choice % side_length + 1);
+    }
+
+    return true;
+}
+
+/**
+ * Copies the solved board (or the givens if unsolved) into a caller-owned buffer
+ *
+ * @param cells (buffer of at least side_length * side_length values)
+ */
+void DancingLinks::storeCells(uint8_t *cells) const {
+    if (!board.empty()) {
+        std::memcpy(cells, board.data(), board.size());
+    }
+}
+
+/**
+ * Registers a flag that aborts the search once it becomes true
+ *
+ * @param flag (shared flag, or nullptr to run uncancellable)
+ */
+void DancingLinks::setCancelFlag(const std::atomic<bool> *flag) {
+    cancel_flag = flag;
+}
+
+/**
+ * @return true if the last solve stopped because its cancel flag was raised
+ */
+bool DancingLinks::wasCancelled() const {
+    return cancelled;
+}
+
+/**
+ * @return number of search nodes expanded by the last solve
+ */
+unsigned long long DancingLinks::getNodeCount() const {
+    return node_count;
+}
+
+/**
+ * Appends one matrix row covering the four constraints of placing val on cell
+ */
+void DancingLinks::addRow(int cell, int val) {
+    int cell_count = side_length * side_length;
+    int row_number = cell / side_length;
+    int col_number = cell % side_length;
+    int box_number = (row_number / box_size) * box_size + col_number / box_size;
+    int columns[4] = {
+            1 + cell,
+            1 + cell_count + row_number * side_length + val - 1,
+            1 + 2 * cell_count + col_number * side_length + val - 1,
+            1 + 3 * cell_count + box_number * side_length + val - 1
+    };
+
+    int first = (int) left.size();
+    for (int x = 0; x < 4; ++x) {
+        int node = first + x;
+        int col = columns[x];
+
+        left.push_back(x == 0 ? first + 3 : node - 1);
+        right.push_back(x == 3 ? first : node + 1);
+        up.push_back(up[col]);
+        down.push_back(col);
+        column.push_back(col);
+        node_choice.push_back(cell * side_length + val - 1);
+
+        down[up[col]] = node;                    // links node in at the bottom of col
+        up[col] = node;
+        ++column_size[col];
+    }
+}
+
+/**
+ * Removes a column header and every row that intersects it
+ */
+void DancingLinks::cover(int col) {
+    right[left[col]] = right[col];
+    left[right[col]] = left[col];
+
+    for (int row = down[col]; row != col; row = down[row]) {
+        for (int node = right[row]; node != row; node = right[node]) {
+            up[down[node]] = up[node];
+            down[up[node]] = down[node];
+            --column_size[column[node]];
+        }
+    }
+}
+
+/**
+ * Restores a column removed by cover, in exactly the reverse order
+ */
+void DancingLinks::uncover(int col) {
+    for (int row = up[col]; row != col; row = up[row]) {
+        for (int node = left[row]; node != row; node = left[node]) {
+            ++column_size[column[node]];
+            up[down[node]] = node;
+            down[up[node]] = node;
+        }
+    }
+
+    right[left[col]] = col;
+    left[right[col]] = col;
+}
+
+/**
+ * Recursive Algorithm X step, always branching on the column with fewest nodes
+ *
+ * @return true once every column is covered
+ */
+bool DancingLinks::search() {
+    if (right[0] == 0) {                         // every constraint is satisfied
+        return true;
+    }
+
+    if ((++node_count & 0xff) == 0 && cancel_flag &&
+        cancel_flag->load(std::memory_order_relaxed)) {
+        cancelled = true;
+        return false;
+    }
+
+    int best = right[0];
+    for (int col = right[best]; col != 0; col = right[col]) {
+        if (column_size[col] < column_size[best]) {
+            best = col;
+        }
+    }
+
+    if (column_size[best] == 0) {                // constraint can no longer be met
+        return false;
+    }
+
+    cover(best);
+    for (int row = down[best]; row != best; row = down[row]) {
+        solution.push_back(row);
+        for (int node = right[row]; node != row; node = right[node]) {
+            cover(column[node]);
+        }
+
+        if (search()) {
+            return true;
+        }
+
+        for (int node = left[row]; node != row; node = left[node]) {
+            uncover(column[node]);
+        }
+        solution.pop_back();
+
+        if (cancelled) {
+            break;
+        }
+    }
+    uncover(best);
+
+    return false;
+}
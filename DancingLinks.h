@@ -0,0 +1,100 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef DANCING_LINKS_H
+#define DANCING_LINKS_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Exact-cover solver (Knuth's Algorithm X with dancing links) for square Sudoku boards.
+ * Every (cell, value) pair is a row covering four columns: the cell, the value in its
+ * row, the value in its col and the value in its box. Buffers are kept between arm calls
+ * like SolverContext's.
+ */
+class DancingLinks {
+
+public:
+    /**
+     * constructs an empty solver; the matrix is built on the first call to arm
+     */
+    DancingLinks();
+
+    /**
+    * Builds the exact-cover matrix for a puzzle. Values already ruled out by the givens
+    * are left out of the matrix.
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param side_length (number of rows and cols on the board, must be a square number)
+    * @return false if the puzzle is malformed
+    */
+    bool arm(const uint8_t *cells, int side_length);
+
+    /**
+    * Searches for an exact cover, i.e. a complete board
+    *
+    * @return true if a solution exists, false if not or if the search was cancelled
+    */
+    bool solve();
+
+    /**
+    * Copies the solved board (or the givens if unsolved) into a caller-owned buffer
+    *
+    * @param cells (buffer of at least side_length * side_length values)
+    */
+    void storeCells(uint8_t *cells) const;
+
+    /**
+    * Registers a flag that aborts the search once it becomes true
+    *
+    * @param flag (shared flag, or nullptr to run uncancellable)
+    */
+    void setCancelFlag(const std::atomic<bool> *flag);
+
+    /**
+    * @return true if the last solve stopped because its cancel flag was raised
+    */
+    bool wasCancelled() const;
+
+    /**
+    * @return number of search nodes expanded by the last solve
+    */
+    unsigned long long getNodeCount() const;
+
+private:
+    int side_length;  // number of rows and cols on the board
+    int box_size;     // side length of each inner box
+    int column_count; // 4 * side_length * side_length constraint columns
+    bool armed;       // false if the last arm call was rejected
+    bool cancelled;   // true if the last solve was aborted through cancel_flag
+    unsigned long long node_count;         // nodes expanded by the last solve
+    const std::atomic<bool> *cancel_flag;  // polled during search, may be nullptr
+
+    // node links; nodes 0..column_count are the root and the column headers
+    std::vector<int> left, right, up, down, column;
+    std::vector<int> column_size;   // live nodes under each column header
+    std::vector<int> node_choice;   // (cell * side_length + val - 1) of each row node
+    std::vector<int> solution;      // row nodes chosen so far
+    std::vector<uint8_t> board;     // givens, overwritten with the solution
+
+    /**
+    * Appends one matrix row covering the four constraints of placing val on cell
+    */
+    void addRow(int cell, int val);
+
+    void cover(int col);
+    void uncover(int col);
+
+    /**
+    * Recursive Algorithm X step, always branching on the column with fewest nodes
+    *
+    * @return true once every column is covered
+    */
+    bool search();
+};
+
+#endif // ends DANCING_LINKS_H
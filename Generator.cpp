@@ -0,0 +1,109 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "Generator.h"
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Shuffles values in place (Fisher-Yates)
+ */
+void shuffle(std::vector<int> &values, SearchRandom &random) {
+    for (int x = (int) values.size() - 1; x > 0; --x) {
+        std::swap(values[x], values[random.below((uint32_t) x + 1)]);
+    }
+}
+
+/**
+ * Orders the lines (rows or cols) of a board so that bands stay together: the bands
+ * are shuffled, then the lines within each band
+ *
+ * @param order (set to the source line of each line of the new board)
+ */
+void shuffleLines(int box_size, SearchRandom &random, std::vector<int> &order) {
+    std::vector<int> bands(box_size);
+    std::vector<int> lines(box_size);
+    for (int x = 0; x < box_size; ++x) {
+        bands[x] = x;
+    }
+    shuffle(bands, random);
+
+    order.clear();
+    for (int band : bands) {
+        for (int x = 0; x < box_size; ++x) {
+            lines[x] = band * box_size + x;
+        }
+        shuffle(lines, random);
+        order.insert(order.end(), lines.begin(), lines.end());
+    }
+}
+
+} // namespace
+
+/**
+ * Builds a random solved grid on a standard board
+ *
+ * @param side_length (number of rows and cols, a square number up to 64)
+ * @param random (source of the shuffles)
+ * @param cells (output, side_length * side_length values in row-major order)
+ */
+void generateSolution(int side_length, SearchRandom &random, uint8_t *cells) {
+    int box_size = 1;
+    while (box_size * box_size < side_length) {
+        ++box_size;
+    }
+
+    std::vector<int> rows, cols;
+    std::vector<int> labels(side_length);
+    shuffleLines(box_size, random, rows);
+    shuffleLines(box_size, random, cols);
+    for (int x = 0; x < side_length; ++x) {
+        labels[x] = x + 1;
+    }
+    shuffle(labels, random);
+
+    for (int x = 0; x < side_length; ++x) {
+        int row = rows[x];
+        for (int y = 0; y < side_length; ++y) {
+            int pattern = (row * box_size + row / box_size + cols[y]) % side_length;
+            cells[x * side_length + y] = (uint8_t) labels[pattern];
+        }
+    }
+}
+
+/**
+ * Generates a solvable puzzle by emptying a random fraction of the squares of a random
+ * solved grid
+ *
+ * @param side_length (number of rows and cols, a square number up to 64)
+ * @param holes (fraction of squares to empty, 0 to 1)
+ * @param random (source of the grid and of the squares emptied)
+ * @param puzzle (output, side_length * side_length values, 0 for empty)
+ * @param solution (output, the grid the puzzle was cut from, or nullptr)
+ */
+void generatePuzzle(int side_length, double holes, SearchRandom &random, uint8_t *puzzle,
+                    uint8_t *solution) {
+    int cell_count = side_length * side_length;
+    generateSolution(side_length, random, puzzle);
+    if (solution) {
+        std::memcpy(solution, puzzle, (std::size_t) cell_count);
+    }
+
+    holes = holes < 0 ? 0 : holes > 1 ? 1 : holes;
+    int empty = (int) (holes * cell_count + 0.5);
+    std::vector<int> squares(cell_count);
+    for (int x = 0; x < cell_count; ++x) {
+        squares[x] = x;
+    }
+
+    // a partial Fisher-Yates shuffle picks the squares to empty
+    for (int x = 0; x < empty; ++x) {
+        std::swap(squares[x], squares[x + random.below((uint32_t) (cell_count - x))]);
+        puzzle[squares[x]] = 0;
+    }
+}
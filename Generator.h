@@ -0,0 +1,38 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstdint>
+#include "SearchOptions.h"
+
+/**
+ * Builds a random solved grid on a standard board. Starts from the pattern grid
+ * (row * box + row / box + col) % side + 1 and shuffles rows within bands, the bands,
+ * cols within stacks, the stacks and the value labels, all of which keep it valid.
+ * Takes O(side^2) time, so 64 x 64 grids are as cheap as 9 x 9 ones.
+ *
+ * @param side_length (number of rows and cols, a square number up to 64)
+ * @param random (source of the shuffles)
+ * @param cells (output, side_length * side_length values in row-major order)
+ */
+void generateSolution(int side_length, SearchRandom &random, uint8_t *cells);
+
+/**
+ * Generates a solvable puzzle by emptying a random fraction of the squares of a random
+ * solved grid. The puzzle is not necessarily unique; these instances are meant for
+ * benchmarking and testing large boards, not for play.
+ *
+ * @param side_length (number of rows and cols, a square number up to 64)
+ * @param holes (fraction of squares to empty, 0 to 1)
+ * @param random (source of the grid and of the squares emptied)
+ * @param puzzle (output, side_length * side_length values, 0 for empty)
+ * @param solution (output, the grid the puzzle was cut from, or nullptr)
+ */
+void generatePuzzle(int side_length, double holes, SearchRandom &random, uint8_t *puzzle,
+                    uint8_t *solution = nullptr);
+
+#endif // ends GENERATOR_H
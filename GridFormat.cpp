@@ -0,0 +1,323 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "GridFormat.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const int SYMBOL_SIDE_MAX = 35;    // largest side whose values all have a cell character
+
+/**
+ * Parses a line of whitespace-separated cell tokens
+ *
+ * @return side length of the grid, or 0 if the line is not a square grid
+ */
+int parseTokens(const char *line, std::size_t length, uint8_t *cells) {
+    std::size_t count = 0;
+    std::size_t x = 0;
+
+    while (x < length) {
+        if (line[x] == ' ' || line[x] == '\t') {
+            ++x;
+            continue;
+        }
+
+        std::size_t start = x;
+        while (x < length && line[x] != ' ' && line[x] != '\t') {
+            ++x;
+        }
+
+        int val = x - start == 1 ? cellValue(line[start]) : 0;
+        for (std::size_t y = start; x - start > 1 && y < x && val >= 0; ++y) {
+            bool digit = line[y] >= '0' && line[y] <= '9';
+            val = digit && val < 100 ? val * 10 + (line[y] - '0') : -1;
+        }
+        if (val < 0 || val > 255) {
+            return 0;
+        }
+        cells[count++] = (uint8_t) val;
+    }
+
+    int side_length = (int) (sqrt((double) count));
+    if (count == 0 || (std::size_t) side_length * side_length != count) {
+        return 0;
+    }
+    return side_length;
+}
+
+} // namespace
+
+/**
+ * @return value of a cell character: '1'-'9', then 'A'-'Z' (or 'a'-'z') for 10 and up,
+ * 0 for '0' or '.', -1 for anything else
+ */
+int cellValue(char symbol) {
+    if (symbol >= '0' && symbol <= '9') {
+        return symbol - '0';
+    }
+    if (symbol == '.') {
+        return 0;
+    }
+    if (symbol >= 'A' && symbol <= 'Z') {
+        return symbol - 'A' + 10;
+    }
+    if (symbol >= 'a' && symbol <= 'z') {
+        return symbol - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @return character of a cell value, the inverse of cellValue ('.' for 0)
+ */
+char cellSymbol(int val) {
+    if (val == 0) {
+        return '.';
+    }
+    return (char) (val < 10 ? '0' + val : 'A' + val - 10);
+}
+
+/**
+ * @return bytes formatGrid may write for one grid of this size and style (an upper bound)
+ */
+std::size_t formattedSize(int side_length, GridStyle style) {
+    std::size_t cells = (std::size_t) side_length * side_length;
+
+    switch (style) {
+        case GridStyle::LINE:
+            // up to two digits and a separator per cell above SYMBOL_SIDE_MAX
+            return side_length > SYMBOL_SIDE_MAX ? cells * 3 : cells + 1;
+        case GridStyle::PACKED:
+            return cells;
+        default:
+            // up to two digits and a space per cell, a newline per row; 9 x 9 adds the
+            // "| " separators and two divider lines
+            return cells * 3 + side_length + (side_length == 9 ? 80 : 0);
+    }
+}
+
+/**
+ * Serializes a grid into a caller-owned buffer without allocating
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board)
+ * @param style (layout to write)
+ * @param out (buffer of at least formattedSize(side_length, style) bytes)
+ * @return number of bytes written
+ */
+std::size_t formatGrid(const uint8_t *cells, int side_length, GridStyle style, char *out) {
+    std::size_t count = (std::size_t) side_length * side_length;
+    char *next = out;
+
+    if (style == GridStyle::PACKED) {
+        std::memcpy(out, cells, count);
+        return count;
+    }
+
+    if (style == GridStyle::LINE && side_length > SYMBOL_SIDE_MAX) {
+        for (std::size_t cell = 0; cell < count; ++cell) {
+            int val = cells[cell];
+
+            if (val == 0) {
+                *next++ = '.';
+            } else {
+                if (val >= 10) {
+                    *next++ = (char) ('0' + val / 10);
+                }
+                *next++ = (char) ('0' + val % 10);
+            }
+            *next++ = cell + 1 < count ? ' ' : '\n';
+        }
+        return (std::size_t) (next - out);
+    }
+
+    if (style == GridStyle::LINE) {
+        for (std::size_t cell = 0; cell < count; ++cell) {
+            next[cell] = cellSymbol(cells[cell]);
+        }
+        next[count] = '\n';
+        return count + 1;
+    }
+
+    static const char DIVIDER[] = "------+-------+------\n";
+
+    for (int x = 0; x < side_length; ++x) {
+        for (int y = 0; y < side_length; ++y) {
+            int val = cells[x * side_length + y];
+
+            if (side_length == 9 && y % 3 == 0 && y != 0) {
+                *next++ = '|';
+                *next++ = ' ';
+            }
+            if (val >= 10) {
+                *next++ = (char) ('0' + val / 10);
+            }
+            *next++ = (char) ('0' + val % 10);
+            *next++ = ' ';
+        }
+        *next++ = '\n';
+
+        if (side_length == 9 && (x == 2 || x == 5)) {
+            std::memcpy(next, DIVIDER, sizeof(DIVIDER) - 1);
+            next += sizeof(DIVIDER) - 1;
+        }
+    }
+
+    return (std::size_t) (next - out);
+}
+
+/**
+ * Parses a grid written on one line, one character per cell (the 81-char line format
+ * for 9 x 9), or, when the line holds a space, one whitespace-separated token per cell.
+ * Trailing '\r' is ignored.
+ *
+ * @param line (characters of the line, without the newline)
+ * @param length (number of characters)
+ * @param cells (output buffer of at least length values, row-major)
+ * @return side length of the grid, or 0 if the line is not a square grid
+ */
+int parseLine(const char *line, std::size_t length, uint8_t *cells) {
+    if (length > 0 && line[length - 1] == '\r') {
+        --length;
+    }
+    if (memchr(line, ' ', length)) {
+        return parseTokens(line, length, cells);
+    }
+
+    int side_length = (int) (sqrt((double) length));
+    if (length == 0 || (std::size_t) side_length * side_length != length) {
+        return 0;
+    }
+
+    for (std::size_t x = 0; x < length; ++x) {
+        int val = cellValue(line[x]);
+        if (val < 0) {
+            return 0;
+        }
+        cells[x] = (uint8_t) val;
+    }
+
+    return side_length;
+}
+
+/**
+ * @param file (open stream to read, not closed by the reader)
+ * @param buffer_size (bytes read per refill; longer lines grow the buffer)
+ */
+LineReader::LineReader(FILE *file, std::size_t buffer_size)
+        : file(file), buffer(buffer_size), begin(0), end(0), eof(false) {
+}
+
+/**
+ * @param line (set to the first character of the next line)
+ * @param length (set to its length, without the newline)
+ * @return false at the end of the stream
+ */
+bool LineReader::next(const char *&line, std::size_t &length) {
+    while (true) {
+        const char *start = buffer.data() + begin;
+        const char *newline = (const char *) memchr(start, '\n', end - begin);
+
+        if (newline) {
+            line = start;
+            length = (std::size_t) (newline - start);
+            begin += length + 1;
+            return true;
+        }
+
+        if (eof) {                               // last line without a newline
+            if (begin == end) {
+                return false;
+            }
+            line = start;
+            length = end - begin;
+            begin = end;
+            return true;
+        }
+
+        refill();
+    }
+}
+
+/**
+ * Moves the unread bytes to the front and reads more after them
+ */
+void LineReader::refill() {
+    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+
+    if (end == buffer.size()) {                  // one line fills the whole buffer
+        buffer.resize(buffer.size() * 2);
+    }
+
+    std::size_t got = fread(buffer.data() + end, 1, buffer.size() - end, file);
+    end += got;
+    eof = got == 0;
+}
+
+/**
+ * @param file (open stream to write, not closed by the writer)
+ * @param buffer_size (bytes collected before each write)
+ */
+BufferedWriter::BufferedWriter(FILE *file, std::size_t buffer_size)
+        : file(file), buffer(buffer_size), used(0), failed(false) {
+}
+
+/**
+ * Flushes whatever is still buffered
+ */
+BufferedWriter::~BufferedWriter() {
+    flush();
+}
+
+/**
+ * Appends bytes to the buffer
+ */
+void BufferedWriter::write(const char *data, std::size_t length) {
+    std::memcpy(reserve(length), data, length);
+    used += length;
+}
+
+/**
+ * Formats a grid directly into the buffer
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board)
+ * @param style (layout to write)
+ */
+void BufferedWriter::writeGrid(const uint8_t *cells, int side_length, GridStyle style) {
+    char *out = reserve(formattedSize(side_length, style));
+    used += formatGrid(cells, side_length, style, out);
+}
+
+/**
+ * Hands the buffered bytes to the stream
+ *
+ * @return false if the stream reported an error
+ */
+bool BufferedWriter::flush() {
+    if (used > 0) {
+        failed |= fwrite(buffer.data(), 1, used, file) != used;
+        used = 0;
+    }
+    return !failed && fflush(file) == 0;
+}
+
+/**
+ * @return space for at least length more bytes, flushing or growing the buffer first
+ */
+char *BufferedWriter::reserve(std::size_t length) {
+    if (buffer.size() - used < length && used > 0) {
+        failed |= fwrite(buffer.data(), 1, used, file) != used;
+        used = 0;
+    }
+    if (buffer.size() < length) {                // one record larger than the buffer
+        buffer.resize(length);
+    }
+    return buffer.data() + used;
+}
@@ -0,0 +1,152 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef GRID_FORMAT_H
+#define GRID_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Text and binary layouts a grid can be written in
+ */
+enum class GridStyle {
+    LINE,       // one character per cell ('.' for empty) and a newline: 82 bytes for 9 x 9;
+                // boards over 35 x 35 write space-separated decimal values instead
+    PRETTY,     // rows of space-separated values, boxed for 9 x 9, as Sudoku::print shows
+    PACKED      // one byte per cell, no separators
+};
+
+/**
+ * @return value of a cell character: '1'-'9', then 'A'-'Z' (or 'a'-'z') for 10 and up,
+ * 0 for '0' or '.', -1 for anything else
+ */
+int cellValue(char symbol);
+
+/**
+ * Parses a grid written on one line, one character per cell (the 81-char line format
+ * for 9 x 9), or, when the line holds a space, one whitespace-separated token per cell
+ * (a decimal value or a single cell character), the form boards over 35 x 35 need.
+ * Trailing '\r' is ignored.
+ *
+ * @param line (characters of the line, without the newline)
+ * @param length (number of characters)
+ * @param cells (output buffer of at least length values, row-major)
+ * @return side length of the grid, or 0 if the line is not a square grid
+ */
+int parseLine(const char *line, std::size_t length, uint8_t *cells);
+
+/**
+ * @return character of a cell value, the inverse of cellValue ('.' for 0)
+ */
+char cellSymbol(int val);
+
+/**
+ * @return bytes formatGrid may write for one grid of this size and style (an upper bound)
+ */
+std::size_t formattedSize(int side_length, GridStyle style);
+
+/**
+ * Serializes a grid into a caller-owned buffer without allocating
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board)
+ * @param style (layout to write)
+ * @param out (buffer of at least formattedSize(side_length, style) bytes)
+ * @return number of bytes written
+ */
+std::size_t formatGrid(const uint8_t *cells, int side_length, GridStyle style, char *out);
+
+/**
+ * Reads a stream line by line through one large buffer, handing out each line in
+ * place with no copy and no allocation per line
+ */
+class LineReader {
+
+public:
+    /**
+    * @param file (open stream to read, not closed by the reader)
+    * @param buffer_size (bytes read per refill; longer lines grow the buffer)
+    */
+    explicit LineReader(FILE *file, std::size_t buffer_size = 1 << 20);
+
+    /**
+    * @param line (set to the first character of the next line)
+    * @param length (set to its length, without the newline)
+    * @return false at the end of the stream
+    */
+    bool next(const char *&line, std::size_t &length);
+
+private:
+    FILE *file;
+    std::vector<char> buffer;
+    std::size_t begin;     // first unread byte in buffer
+    std::size_t end;       // one past the last valid byte in buffer
+    bool eof;              // file has no more data
+
+    /**
+    * Moves the unread bytes to the front and reads more after them
+    */
+    void refill();
+};
+
+/**
+ * Collects output in one large buffer and hands it to the stream a buffer at a time, so
+ * formatting millions of grids costs one write call per megabyte instead of one stream
+ * call per cell. Grids are formatted straight into the buffer.
+ */
+class BufferedWriter {
+
+public:
+    /**
+    * @param file (open stream to write, not closed by the writer)
+    * @param buffer_size (bytes collected before each write)
+    */
+    explicit BufferedWriter(FILE *file, std::size_t buffer_size = 1 << 20);
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    /**
+    * Flushes whatever is still buffered
+    */
+    ~BufferedWriter();
+
+    /**
+    * Appends bytes to the buffer
+    */
+    void write(const char *data, std::size_t length);
+
+    /**
+    * Formats a grid directly into the buffer
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param side_length (number of rows and cols on the board)
+    * @param style (layout to write)
+    */
+    void writeGrid(const uint8_t *cells, int side_length, GridStyle style);
+
+    /**
+    * Hands the buffered bytes to the stream
+    *
+    * @return false if the stream reported an error
+    */
+    bool flush();
+
+private:
+    FILE *file;
+    std::vector<char> buffer;
+    std::size_t used;      // bytes of buffer holding output not yet written
+    bool failed;           // a write to the stream came up short
+
+    /**
+    * @return space for at least length more bytes, flushing or growing the buffer first
+    */
+    char *reserve(std::size_t length);
+};
+
+#endif // ends GRID_FORMAT_H
@@ -0,0 +1,151 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "Histogram.h"
+#include <cmath>
+
+namespace {
+
+/**
+ * Adds to a counter owned by the calling thread: a plain load and store, which readers on
+ * other threads still see whole
+ */
+inline void bump(std::atomic<uint64_t> &counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+}
+
+} // namespace
+
+Histogram::Histogram() {
+    reset();
+}
+
+/**
+ * Counts one value; only the owning thread may record
+ */
+void Histogram::record(uint64_t value) {
+    bump(counts[bucketOf(value)], 1);
+    bump(count, 1);
+    bump(sum, value);
+    if (value > max.load(std::memory_order_relaxed)) {
+        max.store(value, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Adds the counts of another histogram, which may be being recorded into. The counters
+ * are read one at a time, so a merge taken mid-recording may be off by the values
+ * recorded while it ran, never by more.
+ */
+void Histogram::merge(const Histogram &other) {
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        uint64_t other_count = other.counts[bucket].load(std::memory_order_relaxed);
+        if (other_count != 0) {
+            bump(counts[bucket], other_count);
+        }
+    }
+    bump(count, other.count.load(std::memory_order_relaxed));
+    bump(sum, other.sum.load(std::memory_order_relaxed));
+
+    uint64_t other_max = other.max.load(std::memory_order_relaxed);
+    if (other_max > max.load(std::memory_order_relaxed)) {
+        max.store(other_max, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Forgets every value
+ */
+void Histogram::reset() {
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        counts[bucket].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @return number of values recorded
+ */
+uint64_t Histogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @return largest value recorded, 0 if none
+ */
+uint64_t Histogram::getMax() const {
+    return max.load(std::memory_order_relaxed);
+}
+
+/**
+ * @return mean of the values recorded, 0 if none
+ */
+double Histogram::getMean() const {
+    uint64_t values = getCount();
+    return values == 0 ? 0 : (double) sum.load(std::memory_order_relaxed) / values;
+}
+
+/**
+ * Walks the buckets up to the one holding the value of rank ceil(percent * count / 100)
+ *
+ * @param percent (share of the values, 0 to 100)
+ * @return smallest value v such that at least percent of the values are at most v,
+ * to bucket precision (never more than the max); 0 if nothing was recorded
+ */
+uint64_t Histogram::valueAt(double percent) const {
+    uint64_t values = getCount();
+    if (values == 0) {
+        return 0;
+    }
+
+    double share = percent < 0 ? 0 : percent > 100 ? 100 : percent;
+    uint64_t rank = (uint64_t) std::ceil(share / 100 * values);
+    rank = rank > 0 ? rank : 1;
+
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += counts[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            uint64_t top = bucketTop(bucket);
+            return top < getMax() ? top : getMax();
+        }
+    }
+    return getMax();
+}
+
+/**
+ * Values below SUB_COUNT map to themselves. A larger value whose top set bit is bit e
+ * keeps its SUB_BITS + 1 leading bits: it lands in sub-bucket (leading bits - SUB_COUNT)
+ * of range e - SUB_BITS + 1.
+ *
+ * @return bucket holding a value
+ */
+int Histogram::bucketOf(uint64_t value) {
+    if (value < (uint64_t) SUB_COUNT) {
+        return (int) value;
+    }
+
+    int shift = 0;
+    while ((value >> shift) >= (uint64_t) 2 * SUB_COUNT) {
+        ++shift;
+    }
+    return (shift + 1) * SUB_COUNT + (int) ((value >> shift) - SUB_COUNT);
+}
+
+/**
+ * @return largest value that falls in a bucket
+ */
+uint64_t Histogram::bucketTop(int bucket) {
+    if (bucket < SUB_COUNT) {
+        return (uint64_t) bucket;
+    }
+
+    int shift = bucket / SUB_COUNT - 1;
+    uint64_t leading = (uint64_t) (bucket % SUB_COUNT + SUB_COUNT);
+    return ((leading + 1) << shift) - 1;
+}
@@ -0,0 +1,114 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Log-bucketed histogram of non-negative integers in the style of HdrHistogram: values
+ * below 32 have a bucket each, and every power-of-two range above that is split into 32
+ * equal buckets, so any recorded value is known to within about 3% with a fixed 15 KB
+ * of counters, whatever the range or the number of values.
+ *
+ * A histogram is meant to be recorded into by one thread, which then needs no atomic
+ * read-modify-write. Any other thread may merge it into another histogram at any time
+ * (every counter is an atomic read relaxed), so per-thread histograms can be summed on
+ * demand while they are still being filled.
+ */
+class Histogram {
+
+public:
+    static const int SUB_BITS = 5;
+    static const int SUB_COUNT = 1 << SUB_BITS;                 // buckets per power of two
+    static const int BUCKETS = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+    Histogram();
+
+    Histogram(const Histogram &) = delete;
+    Histogram &operator=(const Histogram &) = delete;
+
+    /**
+    * Counts one value; only the owning thread may record
+    */
+    void record(uint64_t value);
+
+    /**
+    * Adds the counts of another histogram, which may be being recorded into
+    */
+    void merge(const Histogram &other);
+
+    /**
+    * Forgets every value
+    */
+    void reset();
+
+    /**
+    * @return number of values recorded
+    */
+    uint64_t getCount() const;
+
+    /**
+    * @return largest value recorded, 0 if none
+    */
+    uint64_t getMax() const;
+
+    /**
+    * @return mean of the values recorded, 0 if none
+    */
+    double getMean() const;
+
+    /**
+    * @param percent (share of the values, 0 to 100)
+    * @return smallest value v such that at least percent of the values are at most v,
+    * to bucket precision (never more than the max); 0 if nothing was recorded
+    */
+    uint64_t valueAt(double percent) const;
+
+    /**
+    * @return bucket holding a value
+    */
+    static int bucketOf(uint64_t value);
+
+    /**
+    * @return largest value that falls in a bucket
+    */
+    static uint64_t bucketTop(int bucket);
+
+private:
+    std::atomic<uint64_t> counts[BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+};
+
+/**
+ * Per-puzzle measurements of a batch run: wall time of every solve in nanoseconds and
+ * the search nodes it took
+ */
+struct SolveProfile {
+    Histogram latency;
+    Histogram nodes;
+
+    /**
+    * Adds the measurements of another profile
+    */
+    void merge(const SolveProfile &other) {
+        latency.merge(other.latency);
+        nodes.merge(other.nodes);
+    }
+
+    /**
+    * Forgets every measurement
+    */
+    void reset() {
+        latency.reset();
+        nodes.reset();
+    }
+};
+
+#endif // ends HISTOGRAM_H
@@ -0,0 +1,401 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "Job.h"
+#include "SolverContext.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const std::size_t CHUNK_PUZZLES = 4096;    // puzzles handed to solveBatch at a time
+
+/**
+ * Puzzle counts of one shard
+ */
+struct ShardCounts {
+    unsigned long long puzzles;
+    unsigned long long solved;
+    unsigned long long malformed;
+};
+
+/**
+ * @return true if path names an existing file
+ */
+bool fileExists(const std::string &path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+/**
+ * @return "host pid", written into lock files so a person can tell who holds a shard
+ */
+std::string ownerId() {
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    return std::string(host) + " " + std::to_string((long) getpid());
+}
+
+/**
+ * Writes a small file so that readers see either nothing or all of it: the text goes to
+ * a private temporary file first, which is then renamed over path (replace) or linked
+ * to it (no replace, fails if path exists)
+ *
+ * @return false if the file could not be written, or exists and replace is false
+ */
+bool publishFile(const std::string &path, const std::string &text, bool replace) {
+    std::string owner = ownerId();
+    std::string temp = path + ".tmp." + owner.replace(owner.find(' '), 1, ".");
+
+    FILE *file = fopen(temp.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+    written &= fclose(file) == 0;
+
+    bool published = written && (replace ? rename(temp.c_str(), path.c_str()) == 0 :
+                                           link(temp.c_str(), path.c_str()) == 0);
+    unlink(temp.c_str());                        // no-op after a successful rename
+    return published;
+}
+
+/**
+ * @return contents of a small file, empty if it cannot be read
+ */
+std::string readFile(const std::string &path) {
+    std::string text;
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return text;
+    }
+
+    char buffer[256];
+    std::size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, got);
+    }
+    fclose(file);
+    return text;
+}
+
+/**
+ * Claims a shard's lock file. Whoever gets the record lock on the file still at lock_path
+ * (not one its owner unlinked on finishing) owns the shard and stamps it. An existing file
+ * nobody holds is stale and taken over, including an empty one whose creator died before
+ * locking it; a creator that loses that race simply finds the lock held.
+ *
+ * @return descriptor holding the record lock, or -1 if another process has the shard
+ */
+int claimShard(const std::string &lock_path) {
+    std::string owner = ownerId() + "\n";
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        int fd = open(lock_path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        bool created = fd >= 0;
+
+        if (!created) {
+            if (errno != EEXIST) {
+                return -1;
+            }
+            fd = open(lock_path.c_str(), O_RDWR);
+            if (fd < 0) {
+                continue;                        // owner finished between the two opens
+            }
+        }
+
+        struct flock lock;
+        std::memset(&lock, 0, sizeof(lock));
+        lock.l_type = F_WRLCK;
+        lock.l_whence = SEEK_SET;
+        if (fcntl(fd, F_SETLK, &lock) != 0) {
+            close(fd);                           // held by a live process
+            return -1;
+        }
+
+        struct stat held, current;
+        if (fstat(fd, &held) != 0) {
+            close(fd);
+            return -1;
+        }
+        if (stat(lock_path.c_str(), &current) != 0 || current.st_ino != held.st_ino ||
+            current.st_dev != held.st_dev) {
+            close(fd);                           // taken over and released meanwhile
+            continue;
+        }
+        if (!created && ftruncate(fd, 0) != 0) { // stale: the owner died, take it over
+            close(fd);
+            return -1;
+        }
+
+        if (pwrite(fd, owner.data(), owner.size(), 0) != (ssize_t) owner.size()) {
+            unlink(lock_path.c_str());
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    return -1;
+}
+
+/**
+ * Gives up a claimed shard: the lock file is removed before its record lock is dropped
+ */
+void releaseShard(const std::string &lock_path, int fd) {
+    unlink(lock_path.c_str());
+    close(fd);
+}
+
+/**
+ * Solves the puzzles gathered so far and writes their solutions
+ */
+void flushPuzzles(std::vector<uint8_t> &puzzles, std::vector<uint8_t> &solutions,
+                  const JobConfig &config, BufferedWriter &writer, ShardCounts &counts,
+                  SolveProfile &profile) {
+    std::size_t cells = (std::size_t) config.side_length * config.side_length;
+    std::size_t count = puzzles.size() / cells;
+
+    solutions.resize(puzzles.size());
+    counts.solved += solveBatch(puzzles.data(), solutions.data(), count, config.side_length,
+                                &profile);
+    counts.puzzles += count;
+
+    for (std::size_t x = 0; x < count; ++x) {
+        writer.writeGrid(solutions.data() + x * cells, config.side_length, config.style);
+    }
+    puzzles.clear();
+}
+
+/**
+ * Solves every puzzle line starting in bytes [begin, end) of the input into the shard's
+ * .out file, then publishes its .done file
+ *
+ * @param counts (set to the puzzle counts of the shard)
+ * @param profile (the calling worker's profile, every solve is recorded into it)
+ * @return false on an I/O error
+ */
+bool solveShard(const JobConfig &config, std::size_t shard, off_t begin, off_t end,
+                ShardCounts &counts, SolveProfile &profile) {
+    FILE *input = fopen(config.input.c_str(), "rb");
+    if (!input) {
+        return false;
+    }
+
+    // reading from the byte before the shard, the first line is either the empty tail
+    // of a newline or the rest of a line owned by the previous shard; both are dropped
+    off_t position = begin > 0 ? begin - 1 : 0;
+    if (fseeko(input, position, SEEK_SET) != 0) {
+        fclose(input);
+        return false;
+    }
+
+    std::string out_path = shardPath(config.directory, shard, ".out");
+    std::string temp_path = out_path + ".tmp";
+    FILE *output = fopen(temp_path.c_str(), "wb");
+    if (!output) {
+        fclose(input);
+        return false;
+    }
+
+    std::size_t cells = (std::size_t) config.side_length * config.side_length;
+    counts.puzzles = counts.solved = counts.malformed = 0;
+    std::vector<uint8_t> puzzles, solutions;
+    bool written;
+    {
+        BufferedWriter writer(output);
+        LineReader reader(input);
+        const char *line;
+        std::size_t length;
+
+        if (begin > 0 && reader.next(line, length)) {
+            position += (off_t) length + 1;
+        }
+
+        while (position < end && reader.next(line, length)) {
+            position += (off_t) length + 1;
+
+            std::size_t size = puzzles.size();
+            puzzles.resize(size + length);
+            if (parseLine(line, length, puzzles.data() + size) != config.side_length) {
+                puzzles.resize(size);
+                counts.malformed += length != 0 && !(length == 1 && line[0] == '\r');
+                continue;
+            }
+            puzzles.resize(size + cells);
+
+            if (puzzles.size() == CHUNK_PUZZLES * cells) {
+                flushPuzzles(puzzles, solutions, config, writer, counts, profile);
+            }
+        }
+        flushPuzzles(puzzles, solutions, config, writer, counts, profile);
+        written = writer.flush();
+    }
+
+    written &= !ferror(input);
+    fclose(input);
+    written &= fclose(output) == 0;
+
+    if (!written || rename(temp_path.c_str(), out_path.c_str()) != 0) {
+        unlink(temp_path.c_str());
+        return false;
+    }
+
+    std::string done = std::to_string(counts.puzzles) + " " + std::to_string(counts.solved) +
+                       " " + std::to_string(counts.malformed) + "\n";
+    return publishFile(shardPath(config.directory, shard, ".done"), done, true);
+}
+
+/**
+ * Records the corpus size and settings in job.meta on the first run and checks them on
+ * later runs, so shards of different layouts never mix in one directory
+ *
+ * @return false if the directory belongs to a different job
+ */
+bool checkMeta(const JobConfig &config, off_t input_size, std::string &error) {
+    std::string path = config.directory + "/job.meta";
+    std::string meta = std::to_string((long long) input_size) + " " +
+                       std::to_string(config.shard_bytes) + " " +
+                       std::to_string(config.side_length) + " " +
+                       std::to_string((int) config.style) + "\n";
+
+    if (!fileExists(path) && !publishFile(path, meta, false) && !fileExists(path)) {
+        error = "cannot write " + path;
+        return false;
+    }
+
+    if (readFile(path) != meta) {
+        error = path + " was written for a different input or settings";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @return path of a shard's file with the given suffix (".out", ".lock" or ".done")
+ */
+std::string shardPath(const std::string &directory, std::size_t shard, const char *suffix) {
+    char name[64];
+    snprintf(name, sizeof(name), "/shard-%06zu%s", shard, suffix);
+    return directory + name;
+}
+
+/**
+ * Solves a corpus in shards that survive crashes and can be shared between processes.
+ * Workers take shards in order from a shared counter; a shard is skipped when it is
+ * already done or another process holds its lock.
+ *
+ * @param config (input, output directory and settings)
+ * @param summary (set to what this call did)
+ * @param error (set to a description when the job cannot run)
+ * @return false if the job could not run; shards busy elsewhere are not an error
+ */
+bool runJob(const JobConfig &config, JobSummary &summary, std::string &error) {
+    summary.shards = summary.completed = summary.skipped = summary.busy = 0;
+    summary.puzzles = summary.solved = summary.malformed = 0;
+    summary.profile.reset();
+
+    struct stat input_info;
+    if (stat(config.input.c_str(), &input_info) != 0) {
+        error = "cannot read " + config.input;
+        return false;
+    }
+    if (config.shard_bytes == 0 || config.side_length <= 0 || config.side_length > 64) {
+        error = "bad shard size or side length";
+        return false;
+    }
+    if (mkdir(config.directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        error = "cannot create " + config.directory;
+        return false;
+    }
+    if (!checkMeta(config, input_info.st_size, error)) {
+        return false;
+    }
+
+    off_t size = input_info.st_size;
+    off_t shard_bytes = (off_t) config.shard_bytes;
+    std::size_t shards = (std::size_t) ((size + shard_bytes - 1) / shard_bytes);
+    summary.shards = shards;
+
+    int thread_count = config.thread_count;
+    if (thread_count <= 0) {
+        thread_count = (int) std::thread::hardware_concurrency();
+        thread_count = thread_count > 0 ? thread_count : 1;
+    }
+    if ((std::size_t) thread_count > shards) {
+        thread_count = shards > 0 ? (int) shards : 1;
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex summary_mutex;
+    std::vector<std::thread> workers;
+
+    for (int x = 0; x < thread_count; ++x) {
+        workers.push_back(std::thread([&]() {
+            SolveProfile profile;
+            for (std::size_t shard = next++; shard < shards && !failed; shard = next++) {
+                std::string done_path = shardPath(config.directory, shard, ".done");
+                std::string lock_path = shardPath(config.directory, shard, ".lock");
+
+                if (fileExists(done_path)) {
+                    std::lock_guard<std::mutex> guard(summary_mutex);
+                    ++summary.skipped;
+                    continue;
+                }
+
+                int fd = claimShard(lock_path);
+                if (fd < 0 || fileExists(done_path)) {
+                    if (fd >= 0) {
+                        releaseShard(lock_path, fd);    // finished while we were claiming
+                    }
+                    std::lock_guard<std::mutex> guard(summary_mutex);
+                    ++(fd < 0 ? summary.busy : summary.skipped);
+                    continue;
+                }
+
+                off_t begin = (off_t) shard * shard_bytes;
+                off_t end = begin + shard_bytes < size ? begin + shard_bytes : size;
+                ShardCounts counts;
+                bool solved = solveShard(config, shard, begin, end, counts, profile);
+                releaseShard(lock_path, fd);
+
+                if (!solved) {
+                    failed = true;
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> guard(summary_mutex);
+                ++summary.completed;
+                summary.puzzles += counts.puzzles;
+                summary.solved += counts.solved;
+                summary.malformed += counts.malformed;
+            }
+
+            std::lock_guard<std::mutex> guard(summary_mutex);
+            summary.profile.merge(profile);
+        }));
+    }
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    if (failed) {
+        error = "I/O error while writing to " + config.directory;
+        return false;
+    }
+    return true;
+}
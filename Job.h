@@ -0,0 +1,72 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef JOB_H
+#define JOB_H
+
+#include <cstddef>
+#include <string>
+#include "GridFormat.h"
+#include "Histogram.h"
+
+/**
+ * Settings of a sharded corpus run
+ */
+struct JobConfig {
+    std::string input;          // corpus file, one puzzle per line
+    std::string directory;      // where shard results, locks and the job file live
+    std::size_t shard_bytes;    // bytes of input per shard
+    int side_length;            // side length of every puzzle in the corpus
+    GridStyle style;            // layout of the written solutions
+    int thread_count;           // workers in this process, 0 = one per hardware thread
+
+    JobConfig() : shard_bytes(8 << 20), side_length(9), style(GridStyle::LINE),
+                  thread_count(0) {
+    }
+};
+
+/**
+ * What one runJob call did
+ */
+struct JobSummary {
+    std::size_t shards;         // shards in the corpus
+    std::size_t completed;      // shards solved by this call
+    std::size_t skipped;        // shards already done by an earlier or concurrent run
+    std::size_t busy;           // shards locked by a live process, left to it
+    unsigned long long puzzles; // puzzles in the shards solved by this call
+    unsigned long long solved;  // of those, puzzles with a solution
+    unsigned long long malformed;   // lines that were not a puzzle of the job's size
+    SolveProfile profile;       // time and nodes of every solve of this call
+};
+
+/**
+ * Solves a corpus in shards that survive crashes and can be shared between processes.
+ *
+ * Shard k covers the lines that start in bytes [k * shard_bytes, (k + 1) * shard_bytes)
+ * of the input, so every process derives the same shards without an index. A worker
+ * claims a shard by creating shard-k.lock with O_EXCL and holding a POSIX record lock on
+ * it; a lock file nobody holds a record lock on belongs to a dead process and is taken
+ * over. Solutions go to shard-k.out, one per puzzle line (malformed lines are counted
+ * and left out), and the shard is marked done by renaming its counts into shard-k.done.
+ * Only complete shards ever get a done file, so a restarted run redoes at most the
+ * shards that were in flight.
+ *
+ * The first run writes the corpus size and settings to job.meta; later runs in the same
+ * directory must use the same input and settings. Concatenating the .out files in
+ * shard order gives the results in input order.
+ *
+ * @param config (input, output directory and settings)
+ * @param summary (set to what this call did)
+ * @param error (set to a description when the job cannot run)
+ * @return false if the job could not run; shards busy elsewhere are not an error
+ */
+bool runJob(const JobConfig &config, JobSummary &summary, std::string &error);
+
+/**
+ * @return path of a shard's file with the given suffix (".out", ".lock" or ".done")
+ */
+std::string shardPath(const std::string &directory, std::size_t shard, const char *suffix);
+
+#endif // ends JOB_H
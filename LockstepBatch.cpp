@@ -0,0 +1,295 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "LockstepBatch.h"
+#include "Histogram.h"
+#include "PeerTables.h"
+#include "SolverContext.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+const uint16_t ALL_VALUES = 0x1ff;
+const uint16_t ALL_LANE_BITS = 0xffff;  // alive mask of a lane with no contradiction
+
+// the lane loops carry "#pragma GCC unroll 1": GCC otherwise unrolls a 16-trip loop
+// completely before the loop vectorizer runs, and the straight-line copies it leaves
+// are not vectorized at all
+
+// compile-time 9 x 9 units and peers, shared read-only by every thread
+const PeerTable<3> &table = StandardTables<3>::table;
+
+} // namespace
+
+LockstepBatch::LockstepBatch() {
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * Solves a batch of 9 x 9 puzzles LANES at a time. Each group is propagated in lockstep;
+ * lanes that end up complete are written out directly, lanes with a contradiction are
+ * unsolvable, and the rest continue from their propagated state in SolverContext. With
+ * a profile, every board records an equal share of its group's propagation time, plus
+ * its own search time and nodes if it was peeled off.
+ *
+ * @param context (context the peeled-off boards are searched on)
+ * @param puzzles (count boards of 81 values, back to back, 0 for empty)
+ * @param solutions (output buffer of the same layout, may be puzzles itself;
+ * unsolvable boards are left as given)
+ * @param count (number of boards)
+ * @param found (set to whether each board was solved, or nullptr)
+ * @param profile (profile owned by the calling thread to record every board into, or
+ * nullptr)
+ * @return number of boards solved
+ */
+std::size_t LockstepBatch::solve(SolverContext &context, const uint8_t *puzzles,
+                                 uint8_t *solutions, std::size_t count, bool *found,
+                                 SolveProfile *profile) {
+    std::memset(&stats, 0, sizeof(stats));
+    std::size_t solved = 0;
+
+    for (std::size_t first = 0; first < count; first += LANES) {
+        std::size_t lanes_used = count - first < (std::size_t) LANES ? count - first : LANES;
+        std::chrono::steady_clock::time_point start;
+        if (profile) {
+            start = std::chrono::steady_clock::now();
+        }
+
+        load(puzzles + first * CELLS, lanes_used);
+        propagate();
+        storeLanes();
+
+        uint64_t share = 0;
+        if (profile) {
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+            share = (uint64_t) elapsed.count() / lanes_used;
+        }
+
+        for (std::size_t lane = 0; lane < lanes_used; ++lane) {
+            const uint8_t *puzzle = puzzles + (first + lane) * CELLS;
+            uint8_t *out = solutions + (first + lane) * CELLS;
+            bool lane_found = false;
+            uint64_t nodes = 0;
+            if (profile) {
+                start = std::chrono::steady_clock::now();
+            }
+
+            if (!alive[lane]) {
+                ++stats.unsolvable;
+            } else if (lane_solved[lane]) {
+                ++stats.propagated;
+                lane_found = true;
+                std::memcpy(out, values[lane], CELLS);
+            } else {
+                // single-candidate cells become the givens of the scalar fallback
+                ++stats.peeled;
+                bool armed = context.arm(values[lane], SIDE);
+                lane_found = armed && context.solve(SearchOptions::forSide(SIDE));
+                nodes = armed ? context.getNodeCount() : 0;
+                if (lane_found) {
+                    context.storeCells(out);
+                } else {
+                    ++stats.unsolvable;
+                }
+            }
+
+            if (!lane_found && out != puzzle) {
+                std::memcpy(out, puzzle, CELLS);
+            }
+            solved += lane_found;
+            if (found) {
+                found[first + lane] = lane_found;
+            }
+            if (profile) {
+                std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+                profile->latency.record(share + (uint64_t) elapsed.count());
+                profile->nodes.record(nodes);
+            }
+        }
+    }
+
+    return solved;
+}
+
+/**
+ * @return how the last solve call split its work
+ */
+const LockstepBatch::Stats &LockstepBatch::getStats() const {
+    return stats;
+}
+
+/**
+ * Loads up to LANES puzzles into the lanes; unused lanes get an already solved board
+ * so they drop out of the fixpoint immediately
+ */
+void LockstepBatch::load(const uint8_t *puzzles, std::size_t lanes_used) {
+    for (int lane = 0; lane < LANES; ++lane) {
+        alive[lane] = ALL_LANE_BITS;
+
+        for (int cell = 0; cell < CELLS; ++cell) {
+            int val = (std::size_t) lane < lanes_used ? puzzles[lane * CELLS + cell] : 0;
+
+            if ((std::size_t) lane >= lanes_used) {
+                // any valid full board works as filler; this is the shifted pattern
+                int row_number = cell / SIDE;
+                int col_number = cell % SIDE;
+                val = (row_number * 3 + row_number / 3 + col_number) % SIDE + 1;
+            }
+
+            candidates[cell][lane] = val >= 1 && val <= SIDE ?
+                                     (uint16_t) (1u << (val - 1)) : ALL_VALUES;
+            pushed[cell][lane] = 0;
+            if (val > SIDE) {
+                alive[lane] = 0;
+            }
+        }
+    }
+
+    for (int unit = 0; unit < PeerTable<3>::UNITS; ++unit) {
+        unit_dirty[unit] = true;
+    }
+}
+
+/**
+ * Runs naked-single elimination and hidden-single placement on every lane until no
+ * lane changes any more. All inner loops run over the lanes with no data-dependent
+ * branches, so each step is a handful of vector operations. A cell is only pushed to
+ * its peers when some lane has a single there that it has not pushed yet, and a unit is
+ * only swept for hidden singles after one of its cells changed; dead lanes are masked
+ * out of both, so a pass costs nothing for lanes that have converged.
+ */
+void LockstepBatch::propagate() {
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        // naked singles: a new solved cell removes its value from its 20 peers
+        for (int cell = 0; cell < CELLS; ++cell) {
+            uint16_t solo[LANES];
+            uint16_t any = 0;
+            #pragma GCC unroll 1
+            for (int lane = 0; lane < LANES; ++lane) {
+                uint16_t mask = candidates[cell][lane];
+                uint16_t single = (mask & (mask - 1)) == 0 ? mask : 0;
+                solo[lane] = single & (uint16_t) ~pushed[cell][lane] & alive[lane];
+                pushed[cell][lane] |= solo[lane];
+                any |= solo[lane];
+            }
+            if (!any) {
+                continue;
+            }
+
+            for (int x = 0; x < PeerTable<3>::PEERS; ++x) {
+                int other = table.peer_data[cell * PeerTable<3>::PEERS + x];
+                uint16_t *peer = candidates[other];
+                uint16_t diff = 0;
+                #pragma GCC unroll 1
+                for (int lane = 0; lane < LANES; ++lane) {
+                    uint16_t next = peer[lane] & (uint16_t) ~solo[lane];
+                    diff |= next ^ peer[lane];
+                    alive[lane] &= next == 0 ? 0 : ALL_LANE_BITS;
+                    peer[lane] = next;
+                }
+                if (diff) {
+                    markUnits(other);
+                    changed = true;
+                }
+            }
+        }
+
+        // hidden singles: a value with one possible cell in a unit is placed there
+        for (int unit = 0; unit < PeerTable<3>::UNITS; ++unit) {
+            if (!unit_dirty[unit]) {
+                continue;
+            }
+            unit_dirty[unit] = false;
+
+            uint16_t once[LANES];
+            uint16_t twice[LANES];
+            #pragma GCC unroll 1
+            for (int lane = 0; lane < LANES; ++lane) {
+                once[lane] = 0;
+                twice[lane] = 0;
+            }
+
+            for (int x = 0; x < SIDE; ++x) {
+                const uint16_t *mask = candidates[table.unit_data[unit * SIDE + x]];
+                #pragma GCC unroll 1
+                for (int lane = 0; lane < LANES; ++lane) {
+                    twice[lane] |= once[lane] & mask[lane];
+                    once[lane] |= mask[lane];
+                }
+            }
+
+            #pragma GCC unroll 1
+            for (int lane = 0; lane < LANES; ++lane) {
+                // some value has no cell left
+                alive[lane] &= once[lane] == ALL_VALUES ? ALL_LANE_BITS : 0;
+                once[lane] &= (uint16_t) ~twice[lane] & alive[lane];
+            }
+
+            for (int x = 0; x < SIDE; ++x) {
+                int cell = table.unit_data[unit * SIDE + x];
+                uint16_t *mask = candidates[cell];
+                uint16_t diff = 0;
+                #pragma GCC unroll 1
+                for (int lane = 0; lane < LANES; ++lane) {
+                    uint16_t hidden = mask[lane] & once[lane];
+                    uint16_t next = hidden ? hidden : mask[lane];
+                    diff |= next ^ mask[lane];
+                    mask[lane] = next;
+                }
+                if (diff) {
+                    markUnits(cell);
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Marks the three units of a cell for the next hidden-single sweep
+ */
+void LockstepBatch::markUnits(int cell) {
+    for (int x = 0; x < 3; ++x) {
+        unit_dirty[table.cell_unit_data[cell * 3 + x]] = true;
+    }
+}
+
+/**
+ * Decodes every lane into values, with 0 for cells holding more than one candidate,
+ * and sets lane_solved for the lanes where no cell does. A single bit's position is read off
+ * four mask tests, so the decode stays branch-free across the lanes.
+ */
+void LockstepBatch::storeLanes() {
+    uint16_t open[LANES];
+    #pragma GCC unroll 1
+    for (int lane = 0; lane < LANES; ++lane) {
+        open[lane] = 0;
+    }
+
+    for (int cell = 0; cell < CELLS; ++cell) {
+        uint8_t decoded[LANES];
+        #pragma GCC unroll 1
+        for (int lane = 0; lane < LANES; ++lane) {
+            uint16_t mask = candidates[cell][lane];
+            uint16_t single = (mask & (mask - 1)) == 0 ? mask : 0;
+            open[lane] |= single == 0;
+            decoded[lane] = (uint8_t) (((single & 0x0aa) != 0) | ((single & 0x0cc) != 0) << 1 |
+                                       ((single & 0x0f0) != 0) << 2 |
+                                       ((single & 0x100) != 0) << 3) + (single != 0);
+        }
+        for (int lane = 0; lane < LANES; ++lane) {
+            values[lane][cell] = decoded[lane];
+        }
+    }
+
+    for (int lane = 0; lane < LANES; ++lane) {
+        lane_solved[lane] = !open[lane];
+    }
+}
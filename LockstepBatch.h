@@ -0,0 +1,96 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef LOCKSTEP_BATCH_H
+#define LOCKSTEP_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+class SolverContext;
+struct SolveProfile;
+
+/**
+ * Batch engine for 9 x 9 puzzles that runs constraint propagation on LANES puzzles at
+ * once. Candidates are stored struct-of-arrays (candidates[cell][lane]) and every update
+ * is a branch-free loop over the lanes, which the compiler turns into SIMD code. Singles
+ * already pushed to their peers and units no lane changed are skipped, so lanes that
+ * have converged cost nothing further. Lanes that propagation cannot finish are peeled
+ * off to the scalar SolverContext search.
+ */
+class LockstepBatch {
+
+public:
+    static const int LANES = 16;   // puzzles propagated together
+    static const int SIDE = 9;     // only 9 x 9 boards are supported
+    static const int CELLS = 81;
+
+    /**
+     * Counters describing how the last solve call split its work
+     */
+    struct Stats {
+        std::size_t propagated;  // puzzles solved by lockstep propagation alone
+        std::size_t peeled;      // puzzles handed to the scalar search
+        std::size_t unsolvable;  // puzzles with no solution
+    };
+
+    LockstepBatch();
+
+    /**
+    * Solves a batch of 9 x 9 puzzles.
+    *
+    * @param context (context the peeled-off boards are searched on)
+    * @param puzzles (count boards of 81 values, back to back, 0 for empty)
+    * @param solutions (output buffer of the same layout, may be puzzles itself;
+    * unsolvable boards are left as given)
+    * @param count (number of boards)
+    * @param found (set to whether each board was solved, or nullptr)
+    * @param profile (profile owned by the calling thread to record every board into, or
+    * nullptr)
+    * @return number of boards solved
+    */
+    std::size_t solve(SolverContext &context, const uint8_t *puzzles, uint8_t *solutions,
+                      std::size_t count, bool *found = nullptr,
+                      SolveProfile *profile = nullptr);
+
+    /**
+    * @return how the last solve call split its work
+    */
+    const Stats &getStats() const;
+
+private:
+    uint16_t candidates[CELLS][LANES];  // candidate bitmask of every cell in every lane
+    uint16_t pushed[CELLS][LANES];      // single already removed from the cell's peers
+    uint16_t alive[LANES];              // all ones until the lane hits a contradiction
+    bool unit_dirty[27];                // some cell of the unit changed in some lane
+    uint8_t values[LANES][CELLS];       // decoded boards, filled by storeLanes
+    bool lane_solved[LANES];            // every cell of the lane holds one candidate
+    Stats stats;
+
+    /**
+    * Loads up to LANES puzzles into the lanes; unused lanes get an already solved board
+    * so they drop out of the fixpoint immediately
+    */
+    void load(const uint8_t *puzzles, std::size_t lanes_used);
+
+    /**
+    * Runs naked-single elimination and hidden-single placement on every lane until no
+    * lane changes any more, revisiting only new singles and units that changed
+    */
+    void propagate();
+
+    /**
+    * Marks the three units of a cell for the next hidden-single sweep
+    */
+    void markUnits(int cell);
+
+    /**
+    * Decodes every lane into values, with 0 for cells holding more than one candidate,
+    * and sets lane_solved for the lanes where no cell does
+    */
+    void storeLanes();
+};
+
+#endif // ends LOCKSTEP_BATCH_H
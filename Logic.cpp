@@ -0,0 +1,412 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "Logic.h"
+
+namespace {
+
+/**
+ * @return number of set bits in the mask
+ */
+inline int countValues(uint64_t mask) {
+    int count = 0;
+    for (; mask; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @return index (0-based value) of the lowest set bit in a non-zero mask
+ */
+inline int lowestValue(uint64_t mask) {
+    int val = 0;
+    while (!(mask & 1ull)) {
+        mask >>= 1;
+        ++val;
+    }
+    return val;
+}
+
+/**
+ * @return true if the cell belongs to the unit
+ */
+bool inUnit(const RegionModel &model, int cell, int unit) {
+    const int *units = model.cellUnits(cell);
+
+    for (int x = model.cellUnitCount(cell) - 1; x >= 0; --x) {
+        if (units[x] == unit) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Starts a step; the buffers of the previous step are cleared but keep their capacity
+ */
+void beginStep(Step &step, Step::Technique technique, int unit, uint64_t values) {
+    step.technique = technique;
+    step.unit = unit;
+    step.value = 0;
+    step.values = values;
+    step.cells.clear();
+    step.eliminations.clear();
+}
+
+bool nakedSingle(const RegionModel &model, const uint64_t *candidates, Step &step) {
+    for (int cell = 0; cell < model.getCellCount(); ++cell) {
+        uint64_t mask = candidates[cell];
+
+        if (mask != 0 && (mask & (mask - 1)) == 0) {
+            beginStep(step, Step::NAKED_SINGLE, -1, mask);
+            step.value = lowestValue(mask) + 1;
+            step.cells.push_back(cell);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hiddenSingle(const RegionModel &model, const uint64_t *candidates, Step &step) {
+    for (int unit = 0; unit < model.getUnitCount(); ++unit) {
+        const int *cells = model.unitCells(unit);
+        int size = model.unitSize(unit);
+        uint64_t once = 0;
+        uint64_t twice = 0;
+
+        if (size != model.getSideLength()) {     // only complete units need every value
+            continue;
+        }
+
+        for (int x = 0; x < size; ++x) {
+            twice |= once & candidates[cells[x]];
+            once |= candidates[cells[x]];
+        }
+
+        uint64_t singles = once & ~twice;
+        if (singles == 0) {
+            continue;
+        }
+
+        uint64_t bit = singles & (~singles + 1);
+        for (int x = 0; x < size; ++x) {
+            if (candidates[cells[x]] & bit) {
+                beginStep(step, Step::HIDDEN_SINGLE, unit, bit);
+                step.value = lowestValue(bit) + 1;
+                step.cells.push_back(cells[x]);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * A value whose squares in unit A all lie in another unit B cannot go anywhere else in
+ * B. With A a box this is "pointing", with A a row or col it is "claiming"; in variant
+ * models any pair of overlapping units works the same way.
+ */
+bool lockedCandidates(const RegionModel &model, const uint64_t *candidates, Step &step) {
+    int side_length = model.getSideLength();
+
+    for (int unit = 0; unit < model.getUnitCount(); ++unit) {
+        const int *cells = model.unitCells(unit);
+        int size = model.unitSize(unit);
+
+        for (int val = 1; val <= side_length; ++val) {
+            uint64_t bit = 1ull << (val - 1);
+            int first = -1;
+            int count = 0;
+
+            for (int x = 0; x < size; ++x) {
+                if ((candidates[cells[x]] & bit) && count++ == 0) {
+                    first = cells[x];
+                }
+            }
+
+            if (count < 2) {
+                continue;
+            }
+
+            // every other unit of the first square that also holds the rest
+            const int *units = model.cellUnits(first);
+            for (int u = 0; u < model.cellUnitCount(first); ++u) {
+                int other = units[u];
+                bool covers = other != unit;
+
+                for (int x = 0; x < size && covers; ++x) {
+                    if ((candidates[cells[x]] & bit) && !inUnit(model, cells[x], other)) {
+                        covers = false;
+                    }
+                }
+                if (!covers) {
+                    continue;
+                }
+
+                beginStep(step, Step::LOCKED_CANDIDATES, unit, bit);
+                const int *other_cells = model.unitCells(other);
+                for (int x = 0; x < model.unitSize(other); ++x) {
+                    int cell = other_cells[x];
+                    if ((candidates[cell] & bit) && !inUnit(model, cell, unit)) {
+                        step.eliminations.push_back(std::pair<int, uint64_t>(cell, bit));
+                    }
+                }
+
+                if (!step.eliminations.empty()) {
+                    for (int x = 0; x < size; ++x) {
+                        if (candidates[cells[x]] & bit) {
+                            step.cells.push_back(cells[x]);
+                        }
+                    }
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool nakedPair(const RegionModel &model, const uint64_t *candidates, Step &step) {
+    for (int unit = 0; unit < model.getUnitCount(); ++unit) {
+        const int *cells = model.unitCells(unit);
+        int size = model.unitSize(unit);
+
+        for (int x = 0; x < size; ++x) {
+            uint64_t pair = candidates[cells[x]];
+            if (countValues(pair) != 2) {
+                continue;
+            }
+
+            for (int y = x + 1; y < size; ++y) {
+                if (candidates[cells[y]] != pair) {
+                    continue;
+                }
+
+                beginStep(step, Step::NAKED_PAIR, unit, pair);
+                for (int z = 0; z < size; ++z) {
+                    uint64_t removed = candidates[cells[z]] & pair;
+                    if (z != x && z != y && removed) {
+                        step.eliminations.push_back(std::pair<int, uint64_t>(cells[z], removed));
+                    }
+                }
+
+                if (!step.eliminations.empty()) {
+                    step.cells.push_back(cells[x]);
+                    step.cells.push_back(cells[y]);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool hiddenPair(const RegionModel &model, const uint64_t *candidates, Step &step) {
+    int side_length = model.getSideLength();
+    uint64_t places[64];                         // squares of the unit holding each value
+
+    for (int unit = 0; unit < model.getUnitCount(); ++unit) {
+        const int *cells = model.unitCells(unit);
+        int size = model.unitSize(unit);
+
+        if (size != side_length) {               // only complete units need every value
+            continue;
+        }
+
+        for (int val = 0; val < side_length; ++val) {
+            places[val] = 0;
+            for (int x = 0; x < size; ++x) {
+                if (candidates[cells[x]] & (1ull << val)) {
+                    places[val] |= 1ull << x;
+                }
+            }
+        }
+
+        for (int val = 0; val < side_length; ++val) {
+            if (countValues(places[val]) != 2) {
+                continue;
+            }
+
+            for (int other = val + 1; other < side_length; ++other) {
+                if (places[other] != places[val]) {
+                    continue;
+                }
+
+                uint64_t pair = (1ull << val) | (1ull << other);
+                int first = cells[lowestValue(places[val])];
+                int second = cells[lowestValue(places[val] & (places[val] - 1))];
+
+                beginStep(step, Step::HIDDEN_PAIR, unit, pair);
+                if (candidates[first] & ~pair) {
+                    step.eliminations.push_back(
+                            std::pair<int, uint64_t>(first, candidates[first] & ~pair));
+                }
+                if (candidates[second] & ~pair) {
+                    step.eliminations.push_back(
+                            std::pair<int, uint64_t>(second, candidates[second] & ~pair));
+                }
+
+                if (!step.eliminations.empty()) {
+                    step.cells.push_back(first);
+                    step.cells.push_back(second);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @return "r3c5" style name of a cell (1-based)
+ */
+std::string cellName(int cell, int side_length) {
+    return "r" + std::to_string(cell / side_length + 1) + "c" +
+           std::to_string(cell % side_length + 1);
+}
+
+/**
+ * @return index of the box a unit covers exactly, or -1 if it is not a box (a jigsaw
+ *         region, a diagonal, a window, or any unit on a side that is not a square)
+ */
+int boxIndex(const RegionModel &model, int unit) {
+    int side_length = model.getSideLength();
+    int box_size = 1;
+    while (box_size * box_size < side_length) {
+        ++box_size;
+    }
+    if (box_size * box_size != side_length || model.unitSize(unit) != side_length) {
+        return -1;
+    }
+
+    const int *cells = model.unitCells(unit);
+    int box = -1;
+    for (int x = 0; x < side_length; ++x) {
+        int row = cells[x] / side_length, col = cells[x] % side_length;
+        int cell_box = row / box_size * box_size + col / box_size;
+        if (box >= 0 && cell_box != box) {
+            return -1;
+        }
+        box = cell_box;
+    }
+    return box;
+}
+
+/**
+ * @return "row 3" style name of a unit. Units past rows and cols are named "box n" when
+ *         they cover a box; the others are numbered "region n" in model order.
+ */
+std::string unitName(int unit, const RegionModel &model) {
+    static const char *kinds[] = {"row ", "col "};
+    int side_length = model.getSideLength();
+
+    if (unit < 2 * side_length) {
+        return kinds[unit / side_length] + std::to_string(unit % side_length + 1);
+    }
+
+    int box = boxIndex(model, unit);
+    if (box >= 0) {
+        return "box " + std::to_string(box + 1);
+    }
+
+    int region = 1;
+    for (int other = 2 * side_length; other < unit; ++other) {
+        region += boxIndex(model, other) < 0;
+    }
+    return "region " + std::to_string(region);
+}
+
+/**
+ * @return "{2, 7}" style list of the values in a mask
+ */
+std::string valueList(uint64_t mask) {
+    std::string text = "{";
+
+    for (; mask; mask &= mask - 1) {
+        text += std::to_string(lowestValue(mask) + 1);
+        text += (mask & (mask - 1)) ? ", " : "}";
+    }
+    return text;
+}
+
+} // namespace
+
+/**
+ * @return printable name of a technique
+ */
+const char *techniqueName(Step::Technique technique) {
+    switch (technique) {
+        case Step::NAKED_SINGLE:
+            return "naked single";
+        case Step::HIDDEN_SINGLE:
+            return "hidden single";
+        case Step::LOCKED_CANDIDATES:
+            return "locked candidates";
+        case Step::NAKED_PAIR:
+            return "naked pair";
+        case Step::HIDDEN_PAIR:
+            return "hidden pair";
+        default:
+            return "none";
+    }
+}
+
+/**
+ * Finds the cheapest deduction the candidate masks allow, trying naked singles, hidden
+ * singles, locked candidates, naked pairs and hidden pairs in that order. Only steps
+ * that place a value or remove at least one candidate are reported. Every technique is
+ * a scan of the masks, with no search and no allocation once the step's buffers have
+ * grown.
+ *
+ * @param model (constraint model of the board)
+ * @param candidates (candidate mask of every square, bit val - 1; 0 for filled squares)
+ * @param step (filled with the deduction; its buffers are reused between calls)
+ * @return false if none of the techniques applies
+ */
+bool findStep(const RegionModel &model, const uint64_t *candidates, Step &step) {
+    if (nakedSingle(model, candidates, step) || hiddenSingle(model, candidates, step) ||
+        lockedCandidates(model, candidates, step) || nakedPair(model, candidates, step) ||
+        hiddenPair(model, candidates, step)) {
+        return true;
+    }
+
+    beginStep(step, Step::NONE, -1, 0);
+    return false;
+}
+
+/**
+ * @return one-line description of a step, e.g. "hidden pair {2, 7} in box 7: r7c1 r8c2"
+ */
+std::string describeStep(const Step &step, const RegionModel &model) {
+    int side_length = model.getSideLength();
+    std::string text = techniqueName(step.technique);
+
+    if (step.technique == Step::NAKED_SINGLE || step.technique == Step::HIDDEN_SINGLE) {
+        text += " " + std::to_string(step.value) + " at " + cellName(step.cells[0], side_length);
+        if (step.unit >= 0) {
+            text += " in " + unitName(step.unit, model);
+        }
+        return text;
+    }
+
+    if (step.technique == Step::NONE) {
+        return text;
+    }
+
+    text += " " + valueList(step.values) + " in " + unitName(step.unit, model);
+
+    text += ":";
+    for (int cell : step.cells) {
+        text += " " + cellName(cell, side_length);
+    }
+
+    text += " removes";
+    for (const std::pair<int, uint64_t> &elimination : step.eliminations) {
+        text += " " + valueList(elimination.second) + " from " +
+                cellName(elimination.first, side_length);
+    }
+    return text;
+}
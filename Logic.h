@@ -0,0 +1,64 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef LOGIC_H
+#define LOGIC_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "RegionModel.h"
+
+/**
+ * One human-style deduction on a board, as found by findStep
+ */
+struct Step {
+    /**
+     * Techniques findStep knows, cheapest first
+     */
+    enum Technique {
+        NONE,
+        NAKED_SINGLE,       // a square with one candidate left
+        HIDDEN_SINGLE,      // a value with one square left in a unit
+        LOCKED_CANDIDATES,  // a value confined to the overlap of two units (pointing/claiming)
+        NAKED_PAIR,         // two squares of a unit with the same two candidates
+        HIDDEN_PAIR         // two values confined to the same two squares of a unit
+    };
+
+    Technique technique;
+    int unit;               // unit the deduction is made in, -1 for a naked single
+    int value;              // value placed by a single, 0 otherwise
+    uint64_t values;        // values the deduction is about (bit val - 1)
+    std::vector<int> cells; // squares the deduction rests on; the placed square for singles
+    std::vector<std::pair<int, uint64_t>> eliminations;  // (square, candidates removed)
+
+    Step() : technique(NONE), unit(-1), value(0), values(0) {
+    }
+};
+
+/**
+ * @return printable name of a technique
+ */
+const char *techniqueName(Step::Technique technique);
+
+/**
+ * Finds the cheapest deduction the candidate masks allow, trying naked singles, hidden
+ * singles, locked candidates, naked pairs and hidden pairs in that order. Only steps
+ * that place a value or remove at least one candidate are reported.
+ *
+ * @param model (constraint model of the board)
+ * @param candidates (candidate mask of every square, bit val - 1; 0 for filled squares)
+ * @param step (filled with the deduction; its buffers are reused between calls)
+ * @return false if none of the techniques applies
+ */
+bool findStep(const RegionModel &model, const uint64_t *candidates, Step &step);
+
+/**
+ * @return one-line description of a step, e.g. "hidden pair {2, 7} in box 7: r7c1 r8c2"
+ */
+std::string describeStep(const Step &step, const RegionModel &model);
+
+#endif // ends LOGIC_H
@@ -0,0 +1,98 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef PEER_TABLES_H
+#define PEER_TABLES_H
+
+/**
+ * Compile-time lookup tables of a standard board with box_size x box_size boxes: the
+ * cells of every unit (rows, then cols, then boxes), the three units of every cell and
+ * the peers of every cell (20 on a 9 x 9 board). The tables are laid out in the same
+ * flat offsets + data form RegionModel uses, so a model can point straight at them.
+ */
+template<int BoxSize>
+struct PeerTable {
+    static constexpr int SIDE = BoxSize * BoxSize;
+    static constexpr int CELLS = SIDE * SIDE;
+    static constexpr int UNITS = 3 * SIDE;
+    static constexpr int PEERS = 2 * (SIDE - 1) + (BoxSize - 1) * (BoxSize - 1);
+
+    int unit_offsets[UNITS + 1];
+    int unit_data[UNITS * SIDE];
+    int cell_unit_offsets[CELLS + 1];
+    int cell_unit_data[CELLS * 3];
+    int peer_offsets[CELLS + 1];
+    int peer_data[CELLS * PEERS];
+};
+
+/**
+ * Builds a PeerTable at compile time. Peers are listed row first, then col, then the
+ * rest of the box, each exactly once.
+ */
+template<int BoxSize>
+constexpr PeerTable<BoxSize> buildPeerTable() {
+    typedef PeerTable<BoxSize> Table;
+    Table table = {};
+
+    for (int unit = 0; unit <= Table::UNITS; ++unit) {
+        table.unit_offsets[unit] = unit * Table::SIDE;
+    }
+
+    for (int cell = 0; cell < Table::CELLS; ++cell) {
+        int row_number = cell / Table::SIDE;
+        int col_number = cell % Table::SIDE;
+        int box_number = (row_number / BoxSize) * BoxSize + col_number / BoxSize;
+        int box_offset = (row_number % BoxSize) * BoxSize + col_number % BoxSize;
+
+        table.unit_data[row_number * Table::SIDE + col_number] = cell;
+        table.unit_data[(Table::SIDE + col_number) * Table::SIDE + row_number] = cell;
+        table.unit_data[(2 * Table::SIDE + box_number) * Table::SIDE + box_offset] = cell;
+
+        table.cell_unit_offsets[cell] = cell * 3;
+        table.cell_unit_data[cell * 3] = row_number;
+        table.cell_unit_data[cell * 3 + 1] = Table::SIDE + col_number;
+        table.cell_unit_data[cell * 3 + 2] = 2 * Table::SIDE + box_number;
+
+        table.peer_offsets[cell] = cell * Table::PEERS;
+        int count = 0;
+
+        for (int x = 0; x < Table::SIDE; ++x) {              // rest of the row
+            if (x != col_number) {
+                table.peer_data[cell * Table::PEERS + count++] = row_number * Table::SIDE + x;
+            }
+        }
+        for (int x = 0; x < Table::SIDE; ++x) {              // rest of the col
+            if (x != row_number) {
+                table.peer_data[cell * Table::PEERS + count++] = x * Table::SIDE + col_number;
+            }
+        }
+        for (int x = 0; x < Table::SIDE; ++x) {              // box squares off both lines
+            int other_row = (box_number / BoxSize) * BoxSize + x / BoxSize;
+            int other_col = (box_number % BoxSize) * BoxSize + x % BoxSize;
+            if (other_row != row_number && other_col != col_number) {
+                table.peer_data[cell * Table::PEERS + count++] =
+                        other_row * Table::SIDE + other_col;
+            }
+        }
+    }
+
+    table.cell_unit_offsets[Table::CELLS] = Table::CELLS * 3;
+    table.peer_offsets[Table::CELLS] = Table::CELLS * Table::PEERS;
+    return table;
+}
+
+/**
+ * Read-only tables for the specialized board sizes (4 x 4, 9 x 9 and 16 x 16), generated
+ * by the compiler and shared by every thread
+ */
+template<int BoxSize>
+struct StandardTables {
+    static constexpr PeerTable<BoxSize> table = buildPeerTable<BoxSize>();
+};
+
+template<int BoxSize>
+constexpr PeerTable<BoxSize> StandardTables<BoxSize>::table;
+
+#endif // ends PEER_TABLES_H
@@ -0,0 +1,213 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "Pipeline.h"
+#include "RingQueue.h"
+#include "SolverContext.h"
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * Consecutive input lines and, once a worker is done with them, their solutions. The
+ * buffers keep their capacity when the batch is reused, so a run allocates only while
+ * its first batches fill up.
+ */
+struct Batch {
+    std::size_t sequence;           // position of the batch in the input
+    std::size_t count;              // puzzles in the batch
+    std::size_t solved;             // of those, puzzles solved
+    std::vector<uint8_t> puzzles;   // count boards, back to back
+    std::vector<uint8_t> solutions; // same layout; unsolvable boards are copied as given
+    std::vector<unsigned long long> malformed;  // input index of each malformed line
+};
+
+typedef SpscQueue<Batch *> FreeQueue;      // written batches, writer to reader
+typedef MpmcQueue<Batch *> BatchQueue;     // parsed batches to the workers and solved
+                                           // batches to the writer
+
+/**
+ * Reader stage: parses the input into batches of config.batch_lines non-blank lines,
+ * taking each batch from the free queue, then posts the number of batches and one
+ * nullptr per worker to tell the workers to stop
+ *
+ * @param batch_total (set to the number of batches once the input is exhausted)
+ */
+void readBatches(FILE *input, const PipelineConfig &config, int thread_count,
+                 FreeQueue &free_batches, BatchQueue &work,
+                 std::atomic<std::size_t> &batch_total, PipelineStats &stats) {
+    std::size_t cells = (std::size_t) config.side_length * config.side_length;
+    std::size_t sequence = 0;
+    std::size_t lines = 0;                         // lines in the current batch
+    Batch *batch = nullptr;
+
+    LineReader reader(input);
+    const char *line;
+    std::size_t length;
+
+    while (reader.next(line, length)) {
+        if (length == 0 || (length == 1 && line[0] == '\r')) {
+            continue;
+        }
+        if (!batch) {
+            free_batches.pop(batch);
+            batch->sequence = sequence++;
+            batch->count = 0;
+            batch->puzzles.clear();
+            batch->malformed.clear();
+            lines = 0;
+        }
+
+        std::size_t size = batch->puzzles.size();
+        batch->puzzles.resize(size + (length > cells ? length : cells));
+        if (parseLine(line, length, batch->puzzles.data() + size) == config.side_length) {
+            batch->puzzles.resize(size + cells);
+            ++batch->count;
+        } else {
+            batch->puzzles.resize(size);
+            batch->malformed.push_back(stats.lines);
+            ++stats.malformed;
+        }
+        ++stats.lines;
+
+        if (++lines == config.batch_lines) {
+            work.push(batch);
+            batch = nullptr;
+        }
+    }
+    if (batch) {
+        work.push(batch);
+    }
+
+    batch_total.store(sequence, std::memory_order_release);
+    for (int x = 0; x < thread_count; ++x) {
+        work.push(nullptr);
+    }
+}
+
+/**
+ * Solve stage: pins itself as worker number index, then solves whole batches from the
+ * work queue with solveBatch until it pops a nullptr, recording every solve into its
+ * own profile
+ */
+void solveBatches(const PipelineConfig &config, const Topology &topology, int index,
+                  BatchQueue &work, BatchQueue &solved_batches, SolveProfile &profile) {
+    placeWorker(topology, config.pinning, index);
+    std::size_t cells = (std::size_t) config.side_length * config.side_length;
+
+    while (true) {
+        Batch *batch;
+        work.pop(batch);
+        if (!batch) {
+            return;
+        }
+
+        batch->solutions.resize(batch->count * cells);
+        batch->solved = solveBatch(batch->puzzles.data(), batch->solutions.data(),
+                                   batch->count, config.side_length, &profile);
+        solved_batches.push(batch);
+    }
+}
+
+} // namespace
+
+/**
+ * Solves a stream of one-per-line puzzles into a stream of solutions, in input order,
+ * with memory bounded by the config rather than by the input. The calling thread is the
+ * writer: it parks each solved batch in the slot sequence % batches (no two batches in
+ * flight share one) and writes from the slot of the next sequence while it is filled.
+ *
+ * @param input (stream of puzzles, not closed)
+ * @param output (stream to write the solutions to, not closed)
+ * @param config (board size, output layout, workers and buffer sizes)
+ * @param stats (set to what the run did)
+ * @return false if the output could not be written
+ */
+bool runPipeline(FILE *input, FILE *output, const PipelineConfig &config,
+                 PipelineStats &stats) {
+    stats.lines = stats.puzzles = stats.solved = stats.malformed = 0;
+    stats.batches = 0;
+    stats.profile.reset();
+    if (config.side_length <= 0 || config.side_length > 64 || config.batch_lines == 0) {
+        return false;
+    }
+
+    Topology topology = Topology::detect();
+    int thread_count = config.thread_count > 0 ? config.thread_count : topology.cpuCount();
+    std::size_t batch_count = config.batches > 0 ? config.batches :
+                                                   2 * (std::size_t) thread_count + 2;
+    std::size_t cells = (std::size_t) config.side_length * config.side_length;
+
+    std::vector<Batch> batches(batch_count);
+    std::vector<Batch *> pending(batch_count, nullptr);
+    FreeQueue free_batches(batch_count);
+    BatchQueue work(batch_count + thread_count);
+    BatchQueue solved_batches(batch_count);
+    for (Batch &batch : batches) {
+        free_batches.push(&batch);
+    }
+
+    std::atomic<std::size_t> batch_total(std::numeric_limits<std::size_t>::max());
+    std::thread reader(readBatches, input, std::cref(config), thread_count,
+                       std::ref(free_batches), std::ref(work), std::ref(batch_total),
+                       std::ref(stats));
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<SolveProfile>> profiles;
+    for (int x = 0; x < thread_count; ++x) {
+        profiles.push_back(std::unique_ptr<SolveProfile>(new SolveProfile()));
+        workers.push_back(std::thread(solveBatches, std::cref(config), std::cref(topology),
+                                      x, std::ref(work), std::ref(solved_batches),
+                                      std::ref(*profiles.back())));
+    }
+
+    bool written;
+    {
+        BufferedWriter writer(output);
+        std::size_t next = 0;
+        Backoff backoff;
+
+        while (next < batch_total.load(std::memory_order_acquire)) {
+            Batch *batch;
+            if (!solved_batches.tryPop(batch)) {
+                backoff.pause();
+                continue;
+            }
+            backoff = Backoff();
+            pending[batch->sequence % batch_count] = batch;
+
+            while ((batch = pending[next % batch_count]) != nullptr) {
+                for (std::size_t x = 0; x < batch->count; ++x) {
+                    writer.writeGrid(batch->solutions.data() + x * cells, config.side_length,
+                                     config.style);
+                }
+                for (unsigned long long index : batch->malformed) {
+                    if (config.report) {
+                        fprintf(config.report, "%llu: malformed\n", index);
+                    }
+                }
+                stats.puzzles += batch->count;
+                stats.solved += batch->solved;
+                ++stats.batches;
+
+                pending[next % batch_count] = nullptr;
+                free_batches.push(batch);
+                ++next;
+            }
+        }
+        written = writer.flush();
+    }
+
+    reader.join();
+    for (int x = 0; x < thread_count; ++x) {
+        workers[x].join();
+        stats.profile.merge(*profiles[x]);
+    }
+    return written;
+}
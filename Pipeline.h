@@ -0,0 +1,68 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <cstddef>
+#include <cstdio>
+#include "GridFormat.h"
+#include "Histogram.h"
+#include "WorkerPool.h"
+
+/**
+ * Settings of a streaming solve
+ */
+struct PipelineConfig {
+    int side_length;            // side length of every puzzle in the input
+    GridStyle style;            // layout of the written solutions
+    int thread_count;           // solve workers, 0 = one per CPU the process may run on
+    Pinning pinning;            // CPU binding of the solve workers
+    std::size_t batch_lines;    // input lines per batch
+    std::size_t batches;        // batches in flight, 0 = two per worker plus two;
+                                // with batch_lines this bounds the memory of a run
+    FILE *report;               // where malformed lines are reported, nullptr = nowhere
+
+    PipelineConfig() : side_length(9), style(GridStyle::LINE), thread_count(0),
+                       pinning(Pinning::NODE), batch_lines(1024), batches(0),
+                       report(nullptr) {
+    }
+};
+
+/**
+ * What one runPipeline call did
+ */
+struct PipelineStats {
+    unsigned long long lines;       // non-blank input lines
+    unsigned long long puzzles;     // of those, puzzles of the configured size
+    unsigned long long solved;      // of those, puzzles with a solution
+    unsigned long long malformed;   // lines that were not a puzzle of the configured size
+    std::size_t batches;            // batches that went through the pipeline
+    SolveProfile profile;           // time and nodes of every solve, over all workers
+};
+
+/**
+ * Solves a stream of one-per-line puzzles into a stream of solutions, in input order,
+ * with memory bounded by the config rather than by the input.
+ *
+ * Three stages run at once: a reader thread parses lines into fixed-size batches,
+ * thread_count workers solve whole batches, and the calling thread writes finished
+ * batches in input order, holding back the ones that finish early. Batches come from a
+ * fixed set that the writer hands back to the reader once written, and the stages are
+ * connected by bounded lock-free ring queues, so a fast stage waits on a slow one
+ * instead of buffering: the reader stalls when every batch is in flight, and reading
+ * and writing overlap with solving. Unsolvable puzzles are written as given; malformed
+ * lines are counted, reported to config.report as "index: malformed" and left out.
+ *
+ * @param input (stream of puzzles, not closed)
+ * @param output (stream to write the solutions to, not closed)
+ * @param config (board size, output layout, workers and buffer sizes)
+ * @param stats (set to what the run did)
+ * @return false if the output could not be written
+ */
+bool runPipeline(FILE *input, FILE *output, const PipelineConfig &config,
+                 PipelineStats &stats);
+
+#endif // ends PIPELINE_H
@@ -0,0 +1,139 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "Portfolio.h"
+#include "DancingLinks.h"
+#include "SatSudoku.h"
+#include "SolverContext.h"
+#include "ThreadJoiner.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+/**
+ * @return the standard portfolio: MRV backtracking, propagation + MRV, dancing links,
+ * two randomized value orders, a randomized search with Luby restarts, propagation
+ * with matching filtering and clause learning
+ */
+std::vector<PortfolioConfig> defaultPortfolio() {
+    std::vector<PortfolioConfig> portfolio(8);
+
+    portfolio[0].name = "mrv";
+    portfolio[0].engine = PortfolioConfig::BACKTRACKING;
+
+    portfolio[1].name = "propagate+mrv";
+    portfolio[1].engine = PortfolioConfig::BACKTRACKING;
+    portfolio[1].options.propagate = true;
+
+    portfolio[2].name = "dlx";
+    portfolio[2].engine = PortfolioConfig::DANCING_LINKS;
+
+    for (int x = 3; x < 5; ++x) {
+        portfolio[x].name = "random-values-" + std::to_string(x - 2);
+        portfolio[x].engine = PortfolioConfig::BACKTRACKING;
+        portfolio[x].options.propagate = true;
+        portfolio[x].options.value_order = ValueOrder::RANDOM;
+        portfolio[x].options.seed = (uint64_t) x;
+    }
+
+    portfolio[5].name = "luby-restarts";
+    portfolio[5].engine = PortfolioConfig::BACKTRACKING;
+    portfolio[5].options.propagate = true;
+    portfolio[5].options.value_order = ValueOrder::RANDOM;
+    portfolio[5].options.restarts = RestartPolicy::LUBY;
+    portfolio[5].options.seed = 5;
+
+    portfolio[6].name = "matching";
+    portfolio[6].engine = PortfolioConfig::BACKTRACKING;
+    portfolio[6].options.matching = true;
+
+    // wins on boards whose refutations cost backtracking far more than they cost it
+    portfolio[7].name = "cdcl";
+    portfolio[7].engine = PortfolioConfig::CDCL;
+
+    return portfolio;
+}
+
+/**
+ * Races every entry of the portfolio on its own thread and takes the first one to
+ * finish, whether it found a solution or proved there is none. The losers are
+ * cancelled through a shared flag and joined before returning. If a thread cannot be
+ * started, the entries already racing are cancelled and joined before the
+ * std::system_error propagates.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board)
+ * @param solution (filled with the winner's board when solved)
+ * @param portfolio (entries to race)
+ * @return which entry won and what it found
+ */
+PortfolioResult solvePortfolio(const uint8_t *cells, int side_length, uint8_t *solution,
+                               const std::vector<PortfolioConfig> &portfolio) {
+    PortfolioResult result = {false, -1, 0};
+    std::atomic<bool> cancel(false);
+    std::atomic<int> winner(-1);
+    std::vector<std::thread> workers;
+    ThreadJoiner joiner(workers);
+    workers.reserve(portfolio.size());           // push_back must not throw once started
+
+    try {
+        for (int x = 0; x < (int) portfolio.size(); ++x) {
+            workers.push_back(std::thread([&, x]() {
+                const PortfolioConfig &config = portfolio[x];
+                bool solved = false;
+                bool finished = false;
+                unsigned long long nodes = 0;
+                std::vector<uint8_t> board((std::size_t) side_length * side_length);
+
+                if (config.engine == PortfolioConfig::DANCING_LINKS) {
+                    DancingLinks dlx;
+                    dlx.setCancelFlag(&cancel);
+                    if (dlx.arm(cells, side_length)) {
+                        solved = dlx.solve();
+                        dlx.storeCells(board.data());
+                    }
+                    finished = !dlx.wasCancelled();
+                    nodes = dlx.getNodeCount();
+                } else if (config.engine == PortfolioConfig::CDCL) {
+                    SatSudoku sat;
+                    sat.setCancelFlag(&cancel);
+                    if (sat.arm(cells, side_length)) {
+                        solved = sat.solve();
+                        sat.storeCells(board.data());
+                    }
+                    finished = !sat.wasCancelled();
+                    nodes = sat.getStats().decisions;
+                } else {
+                    SolverPool::Lease context = SolverPool::acquire();
+                    context->setCancelFlag(&cancel);
+                    if (context->arm(cells, side_length)) {
+                        solved = context->solve(config.options);
+                        context->storeCells(board.data());
+                    }
+                    finished = !context->wasCancelled();
+                    nodes = context->getNodeCount();
+                    context->setCancelFlag(nullptr);
+                }
+
+                int expected = -1;
+                if (finished && winner.compare_exchange_strong(expected, x)) {
+                    cancel.store(true);          // tells the losers to stop
+                    result.solved = solved;
+                    result.winner = x;
+                    result.node_count = nodes;
+                    if (solved) {
+                        std::memcpy(solution, board.data(), board.size());
+                    }
+                }
+            }));
+        }
+    } catch (...) {
+        cancel.store(true);                      // stops the entries already racing
+        throw;
+    }
+
+    joiner.join();
+    return result;
+}
@@ -0,0 +1,61 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SearchOptions.h"
+
+/**
+ * One entry of a solving portfolio: which engine to run and how to configure it
+ */
+struct PortfolioConfig {
+    enum Engine {
+        BACKTRACKING,   // SolverContext MRV search, shaped by options
+        DANCING_LINKS,  // exact-cover search; options are ignored
+        CDCL            // SatSudoku clause-learning search; options are ignored
+    };
+
+    std::string name;
+    Engine engine;
+    SearchOptions options;
+};
+
+/**
+ * Outcome of a portfolio race
+ */
+struct PortfolioResult {
+    bool solved;                   // true if the winning entry found a solution
+    int winner;                    // index of the entry that finished first, -1 if none did
+    unsigned long long node_count; // nodes expanded by the winner (decisions for cdcl)
+};
+
+/**
+ * @return the standard portfolio: MRV backtracking, propagation + MRV, dancing links,
+ * two randomized value orders, a randomized search with Luby restarts, propagation
+ * with matching filtering and clause learning
+ */
+std::vector<PortfolioConfig> defaultPortfolio();
+
+/**
+ * Races every entry of the portfolio on its own thread and takes the first one to
+ * finish, whether it found a solution or proved there is none. The losers are
+ * cancelled through a shared flag and joined before returning. If a thread cannot be
+ * started, the entries already racing are cancelled and joined before the
+ * std::system_error propagates.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board)
+ * @param solution (filled with the winner's board when solved)
+ * @param portfolio (entries to race)
+ * @return which entry won and what it found
+ */
+PortfolioResult solvePortfolio(const uint8_t *cells, int side_length, uint8_t *solution,
+                               const std::vector<PortfolioConfig> &portfolio);
+
+#endif // ends PORTFOLIO_H
@@ -0,0 +1,268 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "Rater.h"
+#include "ThreadJoiner.h"
+#include <atomic>
+#include <cmath>
+#include <system_error>
+#include <thread>
+
+/**
+ * @return difficulty score of a single technique: 1.0 for a naked single up to 3.5 for
+ * a hidden pair
+ */
+double techniqueScore(Step::Technique technique) {
+    switch (technique) {
+        case Step::NAKED_SINGLE:
+            return 1.0;
+        case Step::HIDDEN_SINGLE:
+            return 1.5;
+        case Step::LOCKED_CANDIDATES:
+            return 2.5;
+        case Step::NAKED_PAIR:
+            return 3.0;
+        case Step::HIDDEN_PAIR:
+            return 3.5;
+        default:
+            return 0.0;
+    }
+}
+
+Rater::Rater() : model(nullptr), filled(0) {
+}
+
+/**
+ * Rates a puzzle on a standard board
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board, must be a square number)
+ * @return rating of the puzzle
+ */
+Rating Rater::rate(const uint8_t *cells, int side_length) {
+    int box_size = (int) (sqrt(side_length));
+    if (side_length <= 0 || side_length > 64 || box_size * box_size != side_length) {
+        return Rating();
+    }
+
+    if (standard_model.getSideLength() != side_length) {   // only rebuilt on resize
+        standard_model = RegionModel::standard(side_length);
+    }
+
+    return rate(cells, standard_model);
+}
+
+/**
+ * Rates a puzzle constrained by a region model. Techniques used after a guess do not
+ * count towards the hardest technique, since a person who guessed is past rating by
+ * technique; the guess count rates that part instead.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param regions (constraint model of the board, up to 64 x 64)
+ * @return rating of the puzzle
+ */
+Rating Rater::rate(const uint8_t *cells, const RegionModel &regions) {
+    Rating rating;
+    int side_length = regions.getSideLength();
+    int cell_count = regions.getCellCount();
+
+    if (side_length <= 0 || side_length > 64) {
+        return rating;
+    }
+
+    model = &regions;
+    filled = 0;
+    board.assign(cell_count, 0);
+    candidates.assign(cell_count, side_length == 64 ? ~0ull : (1ull << side_length) - 1);
+
+    for (int cell = 0; cell < cell_count; ++cell) {
+        int val = cells[cell];
+        if (val == 0) {
+            continue;
+        }
+
+        // out of range, or taken by a peer given earlier
+        if (val > side_length || !(candidates[cell] & (1ull << (val - 1)))) {
+            return rating;
+        }
+        place(cell, val);
+    }
+
+    rating.solved = search(rating, 0);
+    rating.score = rating.guesses > 0 ? 4.0 + log2((double) rating.guesses) :
+                   techniqueScore(rating.hardest);
+    return rating;
+}
+
+/**
+ * Applies logic until it stalls, then guesses recursively
+ *
+ * @param rating (updated with steps before the first guess and every guess)
+ * @param depth (number of guesses currently in force)
+ * @return true if the board was completed
+ */
+bool Rater::search(Rating &rating, int depth) {
+    while (true) {
+        if (!consistent()) {
+            return false;
+        }
+        if (filled == model->getCellCount()) {
+            return true;
+        }
+        if (!findStep(*model, candidates.data(), step)) {
+            break;
+        }
+
+        if (depth == 0) {
+            ++rating.steps;
+            rating.hardest = step.technique > rating.hardest ? step.technique : rating.hardest;
+        }
+
+        if (step.value != 0) {
+            place(step.cells[0], step.value);
+        } else {
+            for (const std::pair<int, uint64_t> &elimination : step.eliminations) {
+                candidates[elimination.first] &= ~elimination.second;
+            }
+        }
+    }
+
+    // logic stalled: guesses on the square with the fewest candidates
+    int best_cell = -1;
+    int min_value = model->getSideLength() + 1;
+    for (int cell = 0; cell < model->getCellCount(); ++cell) {
+        if (board[cell] != 0) {
+            continue;
+        }
+
+        int curr_value = 0;
+        for (uint64_t mask = candidates[cell]; mask; mask &= mask - 1) {
+            ++curr_value;
+        }
+        if (curr_value < min_value) {
+            min_value = curr_value;
+            best_cell = cell;
+        }
+    }
+
+    if ((int) saved_boards.size() <= depth) {
+        saved_boards.resize(depth + 1);
+        saved_candidates.resize(depth + 1);
+    }
+    saved_boards[depth] = board;
+    saved_candidates[depth] = candidates;
+    int saved_filled = filled;
+
+    for (uint64_t rest = candidates[best_cell]; rest; rest &= rest - 1) {
+        int val = 1;
+        while (!(rest & (1ull << (val - 1)))) {
+            ++val;
+        }
+
+        ++rating.guesses;
+        place(best_cell, val);
+        if (search(rating, depth + 1)) {
+            return true;
+        }
+
+        board = saved_boards[depth];
+        candidates = saved_candidates[depth];
+        filled = saved_filled;
+    }
+
+    return false;
+}
+
+/**
+ * Places a value and removes it from the candidates of the square's peers
+ */
+void Rater::place(int cell, int val) {
+    const int *peers = model->peers(cell);
+    uint64_t bit = ~(1ull << (val - 1));
+
+    for (int x = model->peerCount(cell) - 1; x >= 0; --x) {
+        candidates[peers[x]] &= bit;
+    }
+
+    board[cell] = (uint8_t) val;
+    candidates[cell] = 0;
+    ++filled;
+}
+
+/**
+ * @return false if an empty square or a complete unit has run out of options
+ */
+bool Rater::consistent() const {
+    int side_length = model->getSideLength();
+    uint64_t full = side_length == 64 ? ~0ull : (1ull << side_length) - 1;
+
+    for (int cell = 0; cell < model->getCellCount(); ++cell) {
+        if (board[cell] == 0 && candidates[cell] == 0) {
+            return false;
+        }
+    }
+
+    for (int unit = 0; unit < model->getUnitCount(); ++unit) {
+        const int *cells = model->unitCells(unit);
+        int size = model->unitSize(unit);
+        uint64_t covered = 0;
+
+        if (size != side_length) {
+            continue;
+        }
+
+        for (int x = 0; x < size; ++x) {
+            covered |= board[cells[x]] ? 1ull << (board[cells[x]] - 1) : candidates[cells[x]];
+        }
+        if (covered != full) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Rates a batch of same-size puzzles on every core, one Rater per thread. Workers take
+ * the next unrated puzzle from a shared counter, so slow puzzles do not hold up a whole
+ * slice of the batch. If not every worker can be started, the calling thread rates
+ * alongside the ones that were.
+ *
+ * @param puzzles (count boards of side_length * side_length values, back to back)
+ * @param ratings (output, one rating per board)
+ * @param count (number of boards)
+ * @param side_length (number of rows and cols on every board)
+ * @param thread_count (worker threads, 0 for one per hardware thread)
+ */
+void rateBatch(const uint8_t *puzzles, Rating *ratings, std::size_t count, int side_length,
+               int thread_count) {
+    std::size_t cells = (std::size_t) side_length * side_length;
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> workers;
+    ThreadJoiner joiner(workers);
+
+    if (thread_count <= 0) {
+        thread_count = (int) std::thread::hardware_concurrency();
+        thread_count = thread_count > 0 ? thread_count : 1;
+    }
+
+    auto work = [&]() {
+        Rater rater;
+        for (std::size_t i = next++; i < count; i = next++) {
+            ratings[i] = rater.rate(puzzles + i * cells, side_length);
+        }
+    };
+
+    workers.reserve(thread_count);               // push_back must not throw once started
+    try {
+        for (int x = 0; x < thread_count; ++x) {
+            workers.push_back(std::thread(work));
+        }
+    } catch (const std::system_error &) {
+        work();                                  // too few workers: the caller helps out
+    }
+
+    joiner.join();
+}
@@ -0,0 +1,107 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef RATER_H
+#define RATER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Logic.h"
+#include "RegionModel.h"
+
+/**
+ * Difficulty of a puzzle as judged by Rater
+ */
+struct Rating {
+    bool solved;               // false if the puzzle has no solution (or is malformed)
+    Step::Technique hardest;   // hardest technique needed before the first guess
+    int steps;                 // logical steps applied before the first guess
+    int guesses;               // values tried by guessing once logic stalled
+    double score;              // techniqueScore(hardest), or 4 + log2(guesses) with guesses
+
+    Rating() : solved(false), hardest(Step::NONE), steps(0), guesses(0), score(0) {
+    }
+};
+
+/**
+ * @return difficulty score of a single technique: 1.0 for a naked single up to 3.5 for
+ * a hidden pair
+ */
+double techniqueScore(Step::Technique technique);
+
+/**
+ * Rates puzzles by solving them the way a person would: always applying the cheapest
+ * deduction findStep offers, and guessing on the square with the fewest candidates only
+ * when no technique applies. The result depends on the puzzle alone, never on timings.
+ * A rater reuses its buffers from one puzzle to the next.
+ */
+class Rater {
+
+public:
+    Rater();
+
+    /**
+    * Rates a puzzle on a standard board
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param side_length (number of rows and cols on the board, must be a square number)
+    * @return rating of the puzzle
+    */
+    Rating rate(const uint8_t *cells, int side_length);
+
+    /**
+    * Rates a puzzle constrained by a region model
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param regions (constraint model of the board, up to 64 x 64)
+    * @return rating of the puzzle
+    */
+    Rating rate(const uint8_t *cells, const RegionModel &regions);
+
+private:
+    RegionModel standard_model;        // rows/cols/boxes model used by rate(cells, side)
+    const RegionModel *model;          // model of the puzzle being rated
+    int filled;                        // squares holding a value
+    std::vector<uint8_t> board;        // values placed so far, 0 for empty
+    std::vector<uint64_t> candidates;  // candidates of each empty square, 0 for filled
+    std::vector<std::vector<uint8_t>> saved_boards;        // board before each guess
+    std::vector<std::vector<uint64_t>> saved_candidates;   // candidates before each guess
+    Step step;                         // scratch for findStep
+
+    /**
+    * Applies logic until it stalls, then guesses recursively
+    *
+    * @param rating (updated with steps before the first guess and every guess)
+    * @param depth (number of guesses currently in force)
+    * @return true if the board was completed
+    */
+    bool search(Rating &rating, int depth);
+
+    /**
+    * Places a value and removes it from the candidates of the square's peers
+    */
+    void place(int cell, int val);
+
+    /**
+    * @return false if an empty square or a complete unit has run out of options
+    */
+    bool consistent() const;
+};
+
+/**
+ * Rates a batch of same-size puzzles on every core, one Rater per thread. If not every
+ * worker can be started, the calling thread rates alongside the ones that were.
+ *
+ * @param puzzles (count boards of side_length * side_length values, back to back)
+ * @param ratings (output, one rating per board)
+ * @param count (number of boards)
+ * @param side_length (number of rows and cols on every board)
+ * @param thread_count (worker threads, 0 for one per hardware thread)
+ */
+void rateBatch(const uint8_t *puzzles, Rating *ratings, std::size_t count, int side_length,
+               int thread_count = 0);
+
+#endif // ends RATER_H
@@ -0,0 +1,361 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "RegionModel.h"
+#include "PeerTables.h"
+#include <cmath>
+
+/**
+ * constructs an empty model for a side_length x side_length board
+ */
+RegionModel::RegionModel(int side_length)
+        : side_length(side_length), unit_count(0), shared(false) {
+    unit_offsets.push_back(0);
+    index();
+}
+
+RegionModel::RegionModel(const RegionModel &other)
+        : side_length(other.side_length), unit_count(other.unit_count), shared(other.shared),
+          unit_offsets(other.unit_offsets), unit_data(other.unit_data),
+          cell_unit_offsets(other.cell_unit_offsets), cell_unit_data(other.cell_unit_data),
+          peer_offsets(other.peer_offsets), peer_data(other.peer_data),
+          unit_offsets_view(other.unit_offsets_view), unit_data_view(other.unit_data_view),
+          cell_unit_offsets_view(other.cell_unit_offsets_view),
+          cell_unit_data_view(other.cell_unit_data_view),
+          peer_offsets_view(other.peer_offsets_view), peer_data_view(other.peer_data_view) {
+    if (!shared) {
+        bind();
+    }
+}
+
+RegionModel &RegionModel::operator=(const RegionModel &other) {
+    if (this != &other) {
+        RegionModel copy(other);
+        side_length = copy.side_length;
+        unit_count = copy.unit_count;
+        shared = copy.shared;
+        unit_offsets.swap(copy.unit_offsets);
+        unit_data.swap(copy.unit_data);
+        cell_unit_offsets.swap(copy.cell_unit_offsets);
+        cell_unit_data.swap(copy.cell_unit_data);
+        peer_offsets.swap(copy.peer_offsets);
+        peer_data.swap(copy.peer_data);
+        unit_offsets_view = copy.unit_offsets_view;
+        unit_data_view = copy.unit_data_view;
+        cell_unit_offsets_view = copy.cell_unit_offsets_view;
+        cell_unit_data_view = copy.cell_unit_data_view;
+        peer_offsets_view = copy.peer_offsets_view;
+        peer_data_view = copy.peer_data_view;
+
+        if (!shared) {
+            bind();
+        }
+    }
+    return *this;
+}
+
+/**
+ * @return rows, cols and square boxes of a board with a square side length, or an empty
+ * model if side_length is not a square. The 4 x 4, 9 x 9 and 16 x 16 models share the
+ * compile-time tables and cost nothing to build.
+ */
+RegionModel RegionModel::standard(int side_length) {
+    int box_size = (int) (sqrt(side_length));
+    if (side_length <= 0 || box_size * box_size != side_length) {
+        return RegionModel();
+    }
+
+    RegionModel model(side_length);
+
+    switch (side_length) {
+        case 4:
+            model.share<2>();
+            return model;
+        case 9:
+            model.share<3>();
+            return model;
+        case 16:
+            model.share<4>();
+            return model;
+        default:
+            break;
+    }
+
+    std::vector<int> cells(side_length);
+
+    // units are added directly and indexed once at the end
+    for (int unit = 0; unit < 3 * side_length; ++unit) {
+        int kind = unit / side_length;
+        int which = unit % side_length;
+
+        for (int x = 0; x < side_length; ++x) {
+            if (kind == 0) {                     // row
+                cells[x] = which * side_length + x;
+            } else if (kind == 1) {              // col
+                cells[x] = x * side_length + which;
+            } else {                             // box
+                int row_number = (which / box_size) * box_size + x / box_size;
+                int col_number = (which % box_size) * box_size + x % box_size;
+                cells[x] = row_number * side_length + col_number;
+            }
+        }
+
+        model.unit_data.insert(model.unit_data.end(), cells.begin(), cells.end());
+        model.unit_offsets.push_back((int) model.unit_data.size());
+    }
+
+    model.index();
+    return model;
+}
+
+/**
+ * @return standard model plus both main diagonals (X-sudoku), or an empty model if
+ * side_length is not a square
+ */
+RegionModel RegionModel::diagonal(int side_length) {
+    RegionModel model = standard(side_length);
+    if (model.getSideLength() != side_length) {
+        return model;
+    }
+    std::vector<int> main_diagonal, anti_diagonal;
+
+    for (int x = 0; x < side_length; ++x) {
+        main_diagonal.push_back(x * side_length + x);
+        anti_diagonal.push_back(x * side_length + side_length - 1 - x);
+    }
+
+    model.addUnit(main_diagonal);
+    model.addUnit(anti_diagonal);
+    return model;
+}
+
+/**
+ * @return standard model plus the extra box-sized windows of windoku / hyper sudoku,
+ * one box in from each edge and one cell apart, or an empty model if side_length is not
+ * a square
+ */
+RegionModel RegionModel::windoku(int side_length) {
+    RegionModel model = standard(side_length);
+    if (model.getSideLength() != side_length) {
+        return model;
+    }
+    int box_size = (int) (sqrt(side_length));
+    int windows = (side_length - 1) / (box_size + 1);   // windows per row of windows
+
+    for (int a = 0; a < windows; ++a) {
+        for (int b = 0; b < windows; ++b) {
+            std::vector<int> cells;
+            int top = 1 + a * (box_size + 1);
+            int left = 1 + b * (box_size + 1);
+
+            for (int x = 0; x < box_size; ++x) {
+                for (int y = 0; y < box_size; ++y) {
+                    cells.push_back((top + x) * side_length + left + y);
+                }
+            }
+            model.addUnit(cells);
+        }
+    }
+
+    return model;
+}
+
+/**
+ * Builds a jigsaw model: rows, cols and irregular regions in place of boxes
+ *
+ * @param regions (region number 0..side_length - 1 of every cell, row-major)
+ * @return model, or an empty model if some region does not have side_length cells
+ */
+RegionModel RegionModel::jigsaw(int side_length, const uint8_t *regions) {
+    RegionModel model(side_length);
+    std::vector<std::vector<int>> units(3 * side_length);
+
+    for (int cell = 0; cell < side_length * side_length; ++cell) {
+        if (regions[cell] >= side_length) {
+            return RegionModel();
+        }
+        units[cell / side_length].push_back(cell);
+        units[side_length + cell % side_length].push_back(cell);
+        units[2 * side_length + regions[cell]].push_back(cell);
+    }
+
+    for (const std::vector<int> &unit : units) {
+        if ((int) unit.size() != side_length) {
+            return RegionModel();
+        }
+        model.unit_data.insert(model.unit_data.end(), unit.begin(), unit.end());
+        model.unit_offsets.push_back((int) model.unit_data.size());
+    }
+
+    model.index();
+    return model;
+}
+
+/**
+ * Adds a unit and rebuilds the per-cell tables
+ *
+ * @param cells (cells that must all differ; cell = row * side_length + col)
+ */
+void RegionModel::addUnit(const std::vector<int> &cells) {
+    own();
+    unit_data.insert(unit_data.end(), cells.begin(), cells.end());
+    unit_offsets.push_back((int) unit_data.size());
+    index();
+}
+
+int RegionModel::getSideLength() const {
+    return side_length;
+}
+
+int RegionModel::getCellCount() const {
+    return side_length * side_length;
+}
+
+int RegionModel::getUnitCount() const {
+    return unit_count;
+}
+
+/**
+ * @return number of cells in the unit
+ */
+int RegionModel::unitSize(int unit) const {
+    return unit_offsets_view[unit + 1] - unit_offsets_view[unit];
+}
+
+/**
+ * @return pointer to the unitSize(unit) cells of the unit
+ */
+const int *RegionModel::unitCells(int unit) const {
+    return unit_data_view + unit_offsets_view[unit];
+}
+
+/**
+ * @return number of units the cell belongs to
+ */
+int RegionModel::cellUnitCount(int cell) const {
+    return cell_unit_offsets_view[cell + 1] - cell_unit_offsets_view[cell];
+}
+
+/**
+ * @return pointer to the cellUnitCount(cell) units of the cell
+ */
+const int *RegionModel::cellUnits(int cell) const {
+    return cell_unit_data_view + cell_unit_offsets_view[cell];
+}
+
+/**
+ * @return number of peers of the cell
+ */
+int RegionModel::peerCount(int cell) const {
+    return peer_offsets_view[cell + 1] - peer_offsets_view[cell];
+}
+
+/**
+ * @return pointer to the peerCount(cell) peers of the cell, each listed once
+ */
+const int *RegionModel::peers(int cell) const {
+    return peer_data_view + peer_offsets_view[cell];
+}
+
+/**
+ * Points the model at the compile-time tables for box_size x box_size boxes
+ */
+template<int BoxSize>
+void RegionModel::share() {
+    typedef PeerTable<BoxSize> Table;
+    const Table &table = StandardTables<BoxSize>::table;
+
+    unit_offsets.clear();
+    unit_data.clear();
+    cell_unit_offsets.clear();
+    cell_unit_data.clear();
+    peer_offsets.clear();
+    peer_data.clear();
+
+    shared = true;
+    unit_count = Table::UNITS;
+    unit_offsets_view = table.unit_offsets;
+    unit_data_view = table.unit_data;
+    cell_unit_offsets_view = table.cell_unit_offsets;
+    cell_unit_data_view = table.cell_unit_data;
+    peer_offsets_view = table.peer_offsets;
+    peer_data_view = table.peer_data;
+}
+
+/**
+ * Copies shared tables into the owned vectors so units can be added
+ */
+void RegionModel::own() {
+    if (!shared) {
+        return;
+    }
+
+    int cell_count = side_length * side_length;
+    unit_offsets.assign(unit_offsets_view, unit_offsets_view + unit_count + 1);
+    unit_data.assign(unit_data_view, unit_data_view + unit_offsets_view[unit_count]);
+    cell_unit_offsets.assign(cell_unit_offsets_view, cell_unit_offsets_view + cell_count + 1);
+    cell_unit_data.assign(cell_unit_data_view,
+                          cell_unit_data_view + cell_unit_offsets_view[cell_count]);
+    peer_offsets.assign(peer_offsets_view, peer_offsets_view + cell_count + 1);
+    peer_data.assign(peer_data_view, peer_data_view + peer_offsets_view[cell_count]);
+
+    shared = false;
+    bind();
+}
+
+/**
+ * Points the views at the owned vectors
+ */
+void RegionModel::bind() {
+    unit_count = (int) unit_offsets.size() - 1;
+    unit_offsets_view = unit_offsets.data();
+    unit_data_view = unit_data.data();
+    cell_unit_offsets_view = cell_unit_offsets.data();
+    cell_unit_data_view = cell_unit_data.data();
+    peer_offsets_view = peer_offsets.data();
+    peer_data_view = peer_data.data();
+}
+
+/**
+ * Rebuilds the cell -> units and cell -> peers tables from the unit list. Peers are
+ * de-duplicated, so a cell sharing both a row and a box with another is listed once.
+ */
+void RegionModel::index() {
+    int cell_count = side_length * side_length;
+    std::vector<std::vector<int>> units_of(cell_count);
+
+    bind();
+
+    for (int unit = 0; unit < getUnitCount(); ++unit) {
+        for (int x = 0; x < unitSize(unit); ++x) {
+            units_of[unitCells(unit)[x]].push_back(unit);
+        }
+    }
+
+    cell_unit_offsets.assign(1, 0);
+    cell_unit_data.clear();
+    peer_offsets.assign(1, 0);
+    peer_data.clear();
+
+    std::vector<int> seen(cell_count, -1);     // last cell each peer was recorded for
+    for (int cell = 0; cell < cell_count; ++cell) {
+        for (int unit : units_of[cell]) {
+            cell_unit_data.push_back(unit);
+
+            for (int x = 0; x < unitSize(unit); ++x) {
+                int other = unitCells(unit)[x];
+                if (other != cell && seen[other] != cell) {
+                    seen[other] = cell;
+                    peer_data.push_back(other);
+                }
+            }
+        }
+
+        cell_unit_offsets.push_back((int) cell_unit_data.size());
+        peer_offsets.push_back((int) peer_data.size());
+    }
+
+    bind();
+}
@@ -0,0 +1,138 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef REGION_MODEL_H
+#define REGION_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Constraint model of a board described as generic unit tables: each unit is a list of
+ * cells that must all hold different values. From the units the model precomputes, for
+ * every cell, the units it belongs to and its peers (every other cell sharing a unit),
+ * so solvers never need to know whether a unit is a row, a box, a diagonal or a jigsaw
+ * region. Units with side_length cells must additionally contain every value.
+ *
+ * Standard 4 x 4, 9 x 9 and 16 x 16 models point at the compile-time tables in
+ * PeerTables.h instead of owning a copy; other models own their tables.
+ */
+class RegionModel {
+
+public:
+    /**
+     * constructs an empty model for a side_length x side_length board
+     */
+    explicit RegionModel(int side_length = 0);
+
+    RegionModel(const RegionModel &other);
+    RegionModel &operator=(const RegionModel &other);
+
+    /**
+    * @return rows, cols and square boxes of a board with a square side length, or an
+    * empty model if side_length is not a square
+    */
+    static RegionModel standard(int side_length);
+
+    /**
+    * @return standard model plus both main diagonals (X-sudoku), or an empty model if
+    * side_length is not a square
+    */
+    static RegionModel diagonal(int side_length);
+
+    /**
+    * @return standard model plus the extra box-sized windows of windoku / hyper sudoku,
+    * one box in from each edge and one cell apart, or an empty model if side_length is
+    * not a square
+    */
+    static RegionModel windoku(int side_length);
+
+    /**
+    * Builds a jigsaw model: rows, cols and irregular regions in place of boxes
+    *
+    * @param regions (region number 0..side_length - 1 of every cell, row-major)
+    * @return model, or an empty model if some region does not have side_length cells
+    */
+    static RegionModel jigsaw(int side_length, const uint8_t *regions);
+
+    /**
+    * Adds a unit and rebuilds the per-cell tables
+    *
+    * @param cells (cells that must all differ; cell = row * side_length + col)
+    */
+    void addUnit(const std::vector<int> &cells);
+
+    int getSideLength() const;
+    int getCellCount() const;
+    int getUnitCount() const;
+
+    /**
+    * @return number of cells in the unit
+    */
+    int unitSize(int unit) const;
+
+    /**
+    * @return pointer to the unitSize(unit) cells of the unit
+    */
+    const int *unitCells(int unit) const;
+
+    /**
+    * @return number of units the cell belongs to
+    */
+    int cellUnitCount(int cell) const;
+
+    /**
+    * @return pointer to the cellUnitCount(cell) units of the cell
+    */
+    const int *cellUnits(int cell) const;
+
+    /**
+    * @return number of peers of the cell
+    */
+    int peerCount(int cell) const;
+
+    /**
+    * @return pointer to the peerCount(cell) peers of the cell, each listed once
+    */
+    const int *peers(int cell) const;
+
+private:
+    int side_length;  // number of rows and cols on the board
+    int unit_count;   // number of units in the model
+    bool shared;      // true if the views point at static tables rather than the vectors
+
+    // each table is a flat array plus offsets[i]..offsets[i + 1] per entry
+    std::vector<int> unit_offsets, unit_data;
+    std::vector<int> cell_unit_offsets, cell_unit_data;
+    std::vector<int> peer_offsets, peer_data;
+
+    // what the accessors read: either the vectors above or a static PeerTable
+    const int *unit_offsets_view, *unit_data_view;
+    const int *cell_unit_offsets_view, *cell_unit_data_view;
+    const int *peer_offsets_view, *peer_data_view;
+
+    /**
+    * Points the model at the compile-time tables for box_size x box_size boxes
+    */
+    template<int BoxSize>
+    void share();
+
+    /**
+    * Copies shared tables into the owned vectors so units can be added
+    */
+    void own();
+
+    /**
+    * Points the views at the owned vectors
+    */
+    void bind();
+
+    /**
+    * Rebuilds the cell -> units and cell -> peers tables from the unit list
+    */
+    void index();
+};
+
+#endif // ends REGION_MODEL_H
@@ -0,0 +1,237 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * Wait strategy of a full or empty queue: spins briefly, then yields the CPU so a
+ * stalled stage does not starve the stage it is waiting on
+ */
+class Backoff {
+
+public:
+    Backoff() : spins(0) {
+    }
+
+    /**
+    * Waits a little longer than last time
+    */
+    void pause() {
+        if (spins < SPIN_LIMIT) {
+            ++spins;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static const int SPIN_LIMIT = 64;
+    int spins;
+};
+
+/**
+ * @return smallest power of two that is at least value (and at least 2)
+ */
+inline std::size_t ringCapacity(std::size_t value) {
+    std::size_t capacity = 2;
+    while (capacity < value) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread. Each
+ * side owns one index and only reads the other's, so an operation is one load, one copy
+ * and one release store.
+ */
+template<typename T>
+class SpscQueue {
+
+public:
+    /**
+    * @param capacity (items the queue holds, rounded up to a power of two)
+    */
+    explicit SpscQueue(std::size_t capacity)
+            : slots(ringCapacity(capacity)), mask(slots.size() - 1), head(0), tail(0) {
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+    * @return false if the queue is full
+    */
+    bool tryPush(const T &item) {
+        std::size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == slots.size()) {
+            return false;
+        }
+        slots[position & mask] = item;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    * @return false if the queue is empty
+    */
+    bool tryPop(T &item) {
+        std::size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = slots[position & mask];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    * Pushes, waiting while the queue is full
+    */
+    void push(const T &item) {
+        Backoff backoff;
+        while (!tryPush(item)) {
+            backoff.pause();
+        }
+    }
+
+    /**
+    * Pops, waiting while the queue is empty
+    */
+    void pop(T &item) {
+        Backoff backoff;
+        while (!tryPop(item)) {
+            backoff.pause();
+        }
+    }
+
+private:
+    std::vector<T> slots;
+    std::size_t mask;
+    char padding_head[64];
+    std::atomic<std::size_t> head;     // next slot to pop, written by the consumer
+    char padding_tail[64];
+    std::atomic<std::size_t> tail;     // next slot to push, written by the producer
+    char padding_end[64];
+};
+
+/**
+ * Bounded lock-free queue for any number of producers and consumers. Every slot carries
+ * a sequence number telling whose turn it is: a producer may fill slot i of lap l when
+ * it reads l * capacity + i, a consumer may empty it when it reads one more. Threads
+ * claim a position with a compare-and-swap on the shared cursor and then own the slot,
+ * so the item itself is copied without any further synchronization.
+ */
+template<typename T>
+class MpmcQueue {
+
+public:
+    /**
+    * @param capacity (items the queue holds, rounded up to a power of two)
+    */
+    explicit MpmcQueue(std::size_t capacity)
+            : slots(ringCapacity(capacity)), mask(slots.size() - 1), head(0), tail(0) {
+        for (std::size_t x = 0; x < slots.size(); ++x) {
+            slots[x].sequence.store(x, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    /**
+    * @return false if the queue is full
+    */
+    bool tryPush(const T &item) {
+        std::size_t position = tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            Slot &slot = slots[position & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t lag = (std::ptrdiff_t) (sequence - position);
+
+            if (lag == 0) {
+                if (tail.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;                // the slot still holds last lap's item
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+    * @return false if the queue is empty
+    */
+    bool tryPop(T &item) {
+        std::size_t position = head.load(std::memory_order_relaxed);
+
+        while (true) {
+            Slot &slot = slots[position & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t lag = (std::ptrdiff_t) (sequence - (position + 1));
+
+            if (lag == 0) {
+                if (head.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed)) {
+                    item = slot.item;
+                    slot.sequence.store(position + slots.size(), std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;                // nothing pushed into this slot yet
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+    * Pushes, waiting while the queue is full
+    */
+    void push(const T &item) {
+        Backoff backoff;
+        while (!tryPush(item)) {
+            backoff.pause();
+        }
+    }
+
+    /**
+    * Pops, waiting while the queue is empty
+    */
+    void pop(T &item) {
+        Backoff backoff;
+        while (!tryPop(item)) {
+            backoff.pause();
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    std::vector<Slot> slots;
+    std::size_t mask;
+    char padding_head[64];
+    std::atomic<std::size_t> head;     // next position to pop
+    char padding_tail[64];
+    std::atomic<std::size_t> tail;     // next position to push
+    char padding_end[64];
+};
+
+#endif // ends RING_QUEUE_H
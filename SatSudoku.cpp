@@ -0,0 +1,187 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "SatSudoku.h"
+#include <cmath>
+#include <cstring>
+
+SatSudoku::SatSudoku() : side_length(0), armed(false), cancelled(false) {
+}
+
+/**
+ * Encodes a puzzle on a standard board
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board, must be a square number)
+ * @return false if the puzzle is malformed
+ */
+bool SatSudoku::arm(const uint8_t *cells, int new_side_length) {
+    int box_size = (int) (sqrt(new_side_length));
+    if (new_side_length <= 0 || box_size * box_size != new_side_length) {
+        armed = false;
+        return false;
+    }
+
+    return arm(cells, RegionModel::standard(new_side_length));
+}
+
+/**
+ * Encodes a puzzle constrained by a region model. Givens become unit clauses, and any
+ * value a given rules out on a peer is simply left out of that peer's clauses.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param regions (constraint model of the board)
+ * @return false if the puzzle is malformed
+ */
+bool SatSudoku::arm(const uint8_t *cells, const RegionModel &regions) {
+    armed = false;
+    side_length = regions.getSideLength();
+    int cell_count = regions.getCellCount();
+
+    if (side_length <= 0 || side_length > 64) {
+        return false;
+    }
+
+    board.assign(cells, cells + cell_count);
+    uint64_t full = side_length == 64 ? ~0ull : (1ull << side_length) - 1;
+    allowed.assign(cell_count, full);
+
+    for (int cell = 0; cell < cell_count; ++cell) {
+        int val = board[cell];
+        if (val > side_length) {
+            return false;
+        }
+        if (val == 0) {
+            continue;
+        }
+
+        allowed[cell] = 1ull << (val - 1);
+        for (int x = 0; x < regions.peerCount(cell); ++x) {
+            int peer = regions.peers(cell)[x];
+            if (board[peer] == 0) {
+                allowed[peer] &= ~(1ull << (val - 1));
+            }
+        }
+    }
+
+    solver.reset(cell_count * side_length);
+    std::vector<int> lits;
+
+    for (int cell = 0; cell < cell_count; ++cell) {
+        lits.clear();
+        for (int val = 1; val <= side_length; ++val) {
+            if (allowed[cell] & (1ull << (val - 1))) {
+                lits.push_back(CdclSolver::lit(variable(cell, val)));
+            }
+        }
+
+        solver.addClause(lits);                  // at least one value per cell
+        atMostOne(lits);                         // at most one value per cell
+    }
+
+    for (int unit = 0; unit < regions.getUnitCount(); ++unit) {
+        for (int val = 1; val <= side_length; ++val) {
+            lits.clear();
+            for (int x = 0; x < regions.unitSize(unit); ++x) {
+                int cell = regions.unitCells(unit)[x];
+                if (allowed[cell] & (1ull << (val - 1))) {
+                    lits.push_back(CdclSolver::lit(variable(cell, val)));
+                }
+            }
+
+            if (regions.unitSize(unit) == side_length) {
+                solver.addClause(lits);          // every value somewhere in the unit
+            }
+            atMostOne(lits);                     // and nowhere twice
+        }
+    }
+
+    armed = true;
+    return true;
+}
+
+/**
+ * Runs the CDCL search on the encoded puzzle
+ *
+ * @return true if a solution exists, false if not or if the search was cancelled
+ */
+bool SatSudoku::solve() {
+    cancelled = false;
+    if (!armed) {
+        return false;
+    }
+
+    CdclSolver::Result result = solver.solve();
+    cancelled = result == CdclSolver::UNKNOWN;
+    if (result != CdclSolver::SATISFIABLE) {
+        return false;
+    }
+
+    for (int cell = 0; cell < (int) board.size(); ++cell) {
+        for (int val = 1; val <= side_length; ++val) {
+            if ((allowed[cell] & (1ull << (val - 1))) && solver.modelValue(variable(cell, val))) {
+                board[cell] = (uint8_t) val;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Copies the solved board (or the givens if unsolved) into a caller-owned buffer
+ *
+ * @param cells (buffer of at least side_length * side_length values)
+ */
+void SatSudoku::storeCells(uint8_t *cells) const {
+    if (!board.empty()) {
+        std::memcpy(cells, board.data(), board.size());
+    }
+}
+
+/**
+ * Registers a flag that aborts the search once it becomes true
+ *
+ * @param flag (shared flag, or nullptr to run uncancellable)
+ */
+void SatSudoku::setCancelFlag(const std::atomic<bool> *flag) {
+    solver.setCancelFlag(flag);
+}
+
+/**
+ * @return true if the last solve stopped because its cancel flag was raised
+ */
+bool SatSudoku::wasCancelled() const {
+    return cancelled;
+}
+
+/**
+ * @return counters of the underlying CDCL search
+ */
+const CdclSolver::Stats &SatSudoku::getStats() const {
+    return solver.getStats();
+}
+
+/**
+ * @return CdclSolver variable of value val (1-based) on cell
+ */
+int SatSudoku::variable(int cell, int val) const {
+    return cell * side_length + val - 1;
+}
+
+/**
+ * Adds pairwise at-most-one clauses over the given literals
+ */
+void SatSudoku::atMostOne(const std::vector<int> &lits) {
+    std::vector<int> pair(2);
+
+    for (std::size_t a = 0; a < lits.size(); ++a) {
+        for (std::size_t b = a + 1; b < lits.size(); ++b) {
+            pair[0] = lits[a] ^ 1;
+            pair[1] = lits[b] ^ 1;
+            solver.addClause(pair);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef SAT_SUDOKU_H
+#define SAT_SUDOKU_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "CdclSolver.h"
+#include "RegionModel.h"
+
+/**
+ * Solves a board by encoding it as a propositional formula for CdclSolver. Variable
+ * (cell, value) is true when value sits on cell; the clauses say every cell holds at
+ * least one and at most one value, and every unit holds each value at most once (and at
+ * least once when the unit is complete). Values already ruled out by the givens get no
+ * clauses at all, which keeps large boards compact.
+ *
+ * Meant for 25 x 25 and larger boards, where clause learning avoids the repeated
+ * conflicts chronological backtracking runs into.
+ */
+class SatSudoku {
+
+public:
+    SatSudoku();
+
+    /**
+    * Encodes a puzzle on a standard board
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param side_length (number of rows and cols on the board, must be a square number)
+    * @return false if the puzzle is malformed
+    */
+    bool arm(const uint8_t *cells, int side_length);
+
+    /**
+    * Encodes a puzzle constrained by a region model
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param regions (constraint model of the board)
+    * @return false if the puzzle is malformed
+    */
+    bool arm(const uint8_t *cells, const RegionModel &regions);
+
+    /**
+    * Runs the CDCL search on the encoded puzzle
+    *
+    * @return true if a solution exists, false if not or if the search was cancelled
+    */
+    bool solve();
+
+    /**
+    * Copies the solved board (or the givens if unsolved) into a caller-owned buffer
+    *
+    * @param cells (buffer of at least side_length * side_length values)
+    */
+    void storeCells(uint8_t *cells) const;
+
+    /**
+    * Registers a flag that aborts the search once it becomes true
+    *
+    * @param flag (shared flag, or nullptr to run uncancellable)
+    */
+    void setCancelFlag(const std::atomic<bool> *flag);
+
+    /**
+    * @return true if the last solve stopped because its cancel flag was raised
+    */
+    bool wasCancelled() const;
+
+    /**
+    * @return counters of the underlying CDCL search
+    */
+    const CdclSolver::Stats &getStats() const;
+
+private:
+    int side_length;           // number of rows and cols on the board
+    bool armed;                // false if the last arm call was rejected
+    bool cancelled;            // true if the last solve was aborted
+    std::vector<uint8_t> board;        // givens, overwritten with the solution
+    std::vector<uint64_t> allowed;     // values not ruled out by the givens, per cell
+    CdclSolver solver;
+
+    /**
+    * @return CdclSolver variable of value val (1-based) on cell
+    */
+    int variable(int cell, int val) const;
+
+    /**
+    * Adds pairwise at-most-one clauses over the given literals
+    */
+    void atMostOne(const std::vector<int> &lits);
+};
+
+#endif // ends SAT_SUDOKU_H
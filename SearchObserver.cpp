@@ -0,0 +1,80 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "SearchObserver.h"
+#include <cstring>
+
+namespace {
+
+const char TRACE_MAGIC[] = "SDKTRC";
+const int TRACE_VERSION = 1;
+
+} // namespace
+
+/**
+ * Writes the trace header
+ *
+ * @param file (open stream to write, not closed by the tracer)
+ */
+BinaryTracer::BinaryTracer(FILE *file) : writer(file), records(0) {
+    char header[HEADER_BYTES];
+    std::memcpy(header, TRACE_MAGIC, 6);
+    header[6] = (char) (TRACE_VERSION & 0xff);
+    header[7] = (char) ((TRACE_VERSION >> 8) & 0xff);
+    writer.write(header, HEADER_BYTES);
+}
+
+/**
+ * @return false if the stream reported an error
+ */
+bool BinaryTracer::flush() {
+    return writer.flush();
+}
+
+/**
+ * @return number of records written
+ */
+unsigned long long BinaryTracer::getRecordCount() const {
+    return records;
+}
+
+/**
+ * Decodes a binary trace written by BinaryTracer
+ *
+ * @param path (trace file)
+ * @param records (set to the records of the trace)
+ * @return false if the file cannot be read or is not a complete trace
+ */
+bool readTrace(const std::string &path, std::vector<TraceRecord> &records) {
+    records.clear();
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    unsigned char header[BinaryTracer::HEADER_BYTES];
+    bool valid = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+                 std::memcmp(header, TRACE_MAGIC, 6) == 0 &&
+                 (header[6] | header[7] << 8) == TRACE_VERSION;
+
+    unsigned char bytes[BinaryTracer::RECORD_BYTES];
+    std::size_t got;
+    while (valid && (got = fread(bytes, 1, sizeof(bytes), file)) > 0) {
+        if (got != sizeof(bytes) || bytes[0] > (unsigned char) TraceKind::SOLUTION) {
+            valid = false;
+            break;
+        }
+
+        TraceRecord record;
+        record.kind = (TraceKind) bytes[0];
+        record.val = bytes[1];
+        record.depth = bytes[2] | bytes[3] << 8;
+        record.cell = bytes[4] | bytes[5] << 8;
+        records.push_back(record);
+    }
+
+    fclose(file);
+    return valid;
+}
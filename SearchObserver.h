@@ -0,0 +1,144 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef SEARCH_OBSERVER_H
+#define SEARCH_OBSERVER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "GridFormat.h"
+
+/**
+ * Search observers are plain classes passed to SolverContext::solve as a template
+ * argument, so every hook is a direct, inlinable call and an empty hook compiles away.
+ * An observer provides these members (depth is the number of open decisions):
+ *
+ *   void onStart(int side_length)                   search begins on an armed board
+ *   void onDecision(int depth, int cell, int val)   a branch places val on cell
+ *   void onPropagation(int depth, int cell, int val)  propagation forces val on cell
+ *   void onConflict(int depth)                      propagation found a dead end
+ *   void onBacktrack(int depth)                     a decision ran out of values
+ *   void onSolution(int depth)                      the board is full
+ */
+
+/**
+ * Observer that records nothing; the plain solve runs with it, at no cost
+ */
+struct NullObserver {
+    void onStart(int) {
+    }
+    void onDecision(int, int, int) {
+    }
+    void onPropagation(int, int, int) {
+    }
+    void onConflict(int) {
+    }
+    void onBacktrack(int) {
+    }
+    void onSolution(int) {
+    }
+};
+
+/**
+ * Kinds of record in a binary search trace
+ */
+enum class TraceKind : uint8_t {
+    START,          // cell holds the side length
+    DECISION,
+    PROPAGATION,
+    CONFLICT,
+    BACKTRACK,
+    SOLUTION
+};
+
+/**
+ * One decoded record of a binary search trace
+ */
+struct TraceRecord {
+    TraceKind kind;
+    int depth;      // open decisions when the event fired
+    int cell;       // cell placed on (START: side length), 0 otherwise
+    int val;        // value placed, 0 otherwise
+};
+
+/**
+ * Observer writing every event to a stream as a compact binary trace: an 8-byte header
+ * ("SDKTRC" and a 2-byte version), then one 6-byte record per event holding the kind,
+ * the value and little-endian 16-bit depth and cell. The records of one solve form the
+ * search tree in depth-first order, so a flame graph or tree view can be rebuilt from
+ * the depth column alone. Output goes through a BufferedWriter, so tracing costs one
+ * memory copy per event until the buffer fills.
+ */
+class BinaryTracer {
+
+public:
+    static const int RECORD_BYTES = 6;
+    static const int HEADER_BYTES = 8;
+
+    /**
+    * Writes the trace header
+    *
+    * @param file (open stream to write, not closed by the tracer)
+    */
+    explicit BinaryTracer(FILE *file);
+
+    /**
+    * @return false if the stream reported an error
+    */
+    bool flush();
+
+    /**
+    * @return number of records written
+    */
+    unsigned long long getRecordCount() const;
+
+    void onStart(int side_length) {
+        record(TraceKind::START, 0, side_length, 0);
+    }
+    void onDecision(int depth, int cell, int val) {
+        record(TraceKind::DECISION, depth, cell, val);
+    }
+    void onPropagation(int depth, int cell, int val) {
+        record(TraceKind::PROPAGATION, depth, cell, val);
+    }
+    void onConflict(int depth) {
+        record(TraceKind::CONFLICT, depth, 0, 0);
+    }
+    void onBacktrack(int depth) {
+        record(TraceKind::BACKTRACK, depth, 0, 0);
+    }
+    void onSolution(int depth) {
+        record(TraceKind::SOLUTION, depth, 0, 0);
+    }
+
+private:
+    BufferedWriter writer;
+    unsigned long long records;
+
+    /**
+    * Appends one record
+    */
+    void record(TraceKind kind, int depth, int cell, int val) {
+        const char bytes[RECORD_BYTES] = {
+            (char) kind, (char) val, (char) (depth & 0xff), (char) ((depth >> 8) & 0xff),
+            (char) (cell & 0xff), (char) ((cell >> 8) & 0xff)
+        };
+        writer.write(bytes, RECORD_BYTES);
+        ++records;
+    }
+};
+
+/**
+ * Decodes a binary trace written by BinaryTracer
+ *
+ * @param path (trace file)
+ * @param records (set to the records of the trace)
+ * @return false if the file cannot be read or is not a complete trace
+ */
+bool readTrace(const std::string &path, std::vector<TraceRecord> &records);
+
+#endif // ends SEARCH_OBSERVER_H
@@ -0,0 +1,142 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef SEARCH_OPTIONS_H
+#define SEARCH_OPTIONS_H
+
+#include <cstdint>
+
+/**
+ * Order in which a search tries the candidate values of the square it branches on
+ */
+enum class ValueOrder {
+    ASCENDING,           // 1, 2, 3, ... (the original behaviour)
+    LEAST_CONSTRAINING,  // values that remove the fewest candidates from empty peers first
+    FREQUENCY,           // values already placed most often on the board first
+    RANDOM               // seeded uniform shuffle
+};
+
+/**
+ * @return printable name of a value order, for stats output
+ */
+inline const char *valueOrderName(ValueOrder order) {
+    switch (order) {
+        case ValueOrder::LEAST_CONSTRAINING:
+            return "least-constraining";
+        case ValueOrder::FREQUENCY:
+            return "frequency";
+        case ValueOrder::RANDOM:
+            return "random";
+        default:
+            return "ascending";
+    }
+}
+
+/**
+ * Where a resumable search stands after it returns
+ */
+enum class SearchStatus {
+    SOLVED,       // the board holds a solution
+    UNSOLVABLE,   // every branch failed
+    SUSPENDED,    // the node budget ran out; the search can be continued or saved
+    IDLE          // no search was started, or the board changed since
+};
+
+/**
+ * When a search abandons its current run and starts over from the root
+ */
+enum class RestartPolicy {
+    NONE,        // one run until solved or exhausted (the original behaviour)
+    LUBY,        // run i gets restart_base * luby(i) nodes: 1 1 2 1 1 2 4 1 1 2 ...
+    GEOMETRIC    // run i gets restart_base * 1.5^i nodes
+};
+
+/**
+ * Knobs for a single search. The defaults reproduce plain MRV backtracking with values
+ * tried in ascending order.
+ */
+struct SearchOptions {
+    bool propagate;          // run naked/hidden single propagation after every placement
+    bool matching;           // also prune, once singles run dry, every unit candidate no
+                             // complete matching of the unit uses; implies propagate
+    ValueOrder value_order;  // order candidate values are tried in
+    uint64_t seed;           // seed for every randomized choice, for reproducible runs
+    RestartPolicy restarts;  // restart schedule; any policy but NONE also breaks ties
+                             // between equally constrained cells at random
+    unsigned long long restart_base;  // nodes in the first run of a restart schedule
+    unsigned long long node_limit;    // give up after this many nodes, 0 = no limit
+
+    SearchOptions() : propagate(false), matching(false), value_order(ValueOrder::ASCENDING),
+                      seed(0), restarts(RestartPolicy::NONE), restart_base(64),
+                      node_limit(0) {
+    }
+
+    /**
+    * @return defaults for a board of this size: plain MRV up to 16 x 16, plus single
+    * propagation on larger boards, where one board scan per placement costs far less
+    * than the branches it prunes (36 x 36 and up rarely finish without it)
+    */
+    static SearchOptions forSide(int side_length) {
+        SearchOptions options;
+        options.propagate = side_length > 16;
+        return options;
+    }
+};
+
+/**
+ * Counters reported by a search after it returns
+ */
+struct SearchStats {
+    unsigned long long nodes;       // values placed by the search
+    unsigned long long backtracks;  // branches abandoned after all their values failed
+    unsigned long long backjumps;   // branches skipped because a conflict did not involve them
+    unsigned long long restarts;    // runs abandoned by the restart schedule
+    unsigned long long pruned;      // candidates removed by matching filtering
+    ValueOrder value_order;         // value order the search ran with
+
+    SearchStats() : nodes(0), backtracks(0), backjumps(0), restarts(0), pruned(0),
+                    value_order(ValueOrder::ASCENDING) {
+    }
+};
+
+/**
+ * Small, fast, seedable generator (splitmix64) used for randomized search choices.
+ * Identical seeds give identical searches on every platform.
+ */
+class SearchRandom {
+
+public:
+    explicit SearchRandom(uint64_t seed = 0) : state(seed) {
+    }
+
+    /**
+    * @return next 64 pseudo-random bits
+    */
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+    * @return pseudo-random value in [0, bound)
+    */
+    uint32_t below(uint32_t bound) {
+        return (uint32_t) (next() % bound);
+    }
+
+    /**
+    * @return current state; SearchRandom(getState()) continues the same sequence
+    */
+    uint64_t getState() const {
+        return state;
+    }
+
+private:
+    uint64_t state;
+};
+
+#endif // ends SEARCH_OPTIONS_H
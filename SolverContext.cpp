@@ -0,0 +1,976 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "SolverContext.h"
+#include "LockstepBatch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/**
+ * @return index (0-based value) of the lowest set bit in a non-zero mask
+ */
+inline int lowestValue(uint64_t mask) {
+    int val = 0;
+    while (!(mask & 1ull)) {
+        mask >>= 1;
+        ++val;
+    }
+    return val;
+}
+
+/**
+ * @return number of set bits in the mask
+ */
+inline int countValues(uint64_t mask) {
+    int count = 0;
+    for (; mask; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @return node limit of run number run (0-based) under a restart schedule, 0 for none
+ */
+unsigned long long restartLimit(const SearchOptions &options, int run) {
+    if (options.restarts == RestartPolicy::GEOMETRIC) {
+        return (unsigned long long) (options.restart_base * pow(1.5, run));
+    }
+
+    if (options.restarts == RestartPolicy::LUBY) {
+        // finds the complete subsequence holding run, then the position inside it
+        unsigned long long size = 1;
+        unsigned long long term = 1;
+        unsigned long long index = (unsigned long long) run;
+
+        while (size < index + 1) {
+            size = 2 * size + 1;
+            term *= 2;
+        }
+        while (size - 1 != index) {
+            size = (size - 1) / 2;
+            term /= 2;
+            index %= size;
+        }
+
+        return options.restart_base * term;
+    }
+
+    return 0;
+}
+
+} // namespace
+
+/**
+ * constructs an empty context; buffers are sized on the first call to arm
+ */
+SolverContext::SolverContext()
+        : side_length(0), cell_count(0), armed(false), cancelled(false), matching(false),
+          full_mask(0),
+          cancel_flag(nullptr), model(nullptr), hash(0) {
+}
+
+/**
+ * Re-arms the context with a new puzzle on a standard board, reusing the existing
+ * buffers when the board size has not grown.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board, must be a square number)
+ * @return false if the puzzle is malformed or its givens already conflict
+ */
+bool SolverContext::arm(const uint8_t *cells, int new_side_length) {
+    int new_box_size = (int) (sqrt(new_side_length));
+    if (new_side_length <= 0 || new_side_length > 64 ||
+        new_box_size * new_box_size != new_side_length) {
+        armed = false;
+        return false;
+    }
+
+    if (standard_model.getSideLength() != new_side_length) {   // only rebuilt on resize
+        standard_model = RegionModel::standard(new_side_length);
+    }
+
+    return arm(cells, standard_model);
+}
+
+/**
+ * Re-arms the context with a new puzzle constrained by a region model (diagonals,
+ * windows, jigsaw regions, ...). The model is referenced, not copied.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param regions (constraint model; must outlive every solve on this puzzle)
+ * @return false if the puzzle is malformed or its givens already conflict
+ */
+bool SolverContext::arm(const uint8_t *cells, const RegionModel &regions) {
+    armed = false;
+    stats = SearchStats();
+
+    if (regions.getSideLength() <= 0 || regions.getSideLength() > 64) {
+        return false;
+    }
+
+    model = &regions;
+    side_length = regions.getSideLength();
+    cell_count = regions.getCellCount();
+    full_mask = side_length == 64 ? ~0ull : (1ull << side_length) - 1;
+
+    // resize and clear keep capacity, so same-size puzzles do not allocate
+    board.resize(cell_count);
+    pruned.resize(cell_count);
+    unit_used.resize(regions.getUnitCount());
+    placed_count.resize(side_length + 1);
+    trail.reserve(cell_count);
+    stack.reserve(cell_count);
+
+    std::fill(board.begin(), board.end(), 0);
+    std::fill(pruned.begin(), pruned.end(), 0);
+    std::fill(unit_used.begin(), unit_used.end(), 0);
+    std::fill(placed_count.begin(), placed_count.end(), 0);
+    trail.clear();
+    pruned_trail.clear();
+    stack.clear();
+    hash = 0;
+    matching = false;
+
+    // one key per cell, then one per (unit, value); keys come from a fixed seed so every
+    // context hashes a board the same way
+    std::size_t key_count = (std::size_t) cell_count + regions.getUnitCount() * side_length;
+    if (zobrist.size() != key_count) {
+        zobrist.resize(key_count);
+        SearchRandom keys(0x2b7e151628aed2a6ull);
+        for (uint64_t &key : zobrist) {
+            key = keys.next();
+        }
+    }
+
+    for (int cell = 0; cell < cell_count; ++cell) {
+        int val = cells[cell];
+
+        if (val == 0) {
+            continue;
+        }
+
+        if (val > side_length) {                 // value out of range for the board
+            return false;
+        }
+
+        if (!(candidates(cell) & (1ull << (val - 1)))) {   // conflicts with an earlier given
+            return false;
+        }
+
+        assign(cell, val);
+    }
+
+    trail.clear();                               // givens are never undone
+
+    armed = true;
+    return true;
+}
+
+/**
+ * Solves the armed puzzle with an iterative minimum-remaining-values search. Each
+ * decision is a Frame on the explicit stack, so backtracking is a pop instead of a
+ * return through the call stack.
+ *
+ * With a restart policy every run gets a node limit from the schedule; a run that hits
+ * it is undone back to the givens and the search starts over with fresh random ties and
+ * values. A run that exhausts its stack still proves there is no solution. Both
+ * schedules grow without bound, so the search stays complete.
+ *
+ * @param options (propagation, value-order and restart settings for this search)
+ * @return true if a solution exists, false if not or if the search was cancelled
+ */
+bool SolverContext::solve(const SearchOptions &options) {
+    NullObserver observer;
+    return solve(options, observer);
+}
+
+/**
+ * Solves the armed puzzle like solve(options), reporting every search event to an
+ * observer
+ *
+ * @param options (propagation, value-order and restart settings for this search)
+ * @param observer (receives the search events)
+ * @return true if a solution exists, false if not or if the search was cancelled
+ */
+template<typename Observer>
+bool SolverContext::solve(const SearchOptions &options, Observer &observer) {
+    cancelled = false;
+    stats = SearchStats();
+    stats.value_order = options.value_order;
+
+    if (!armed) {
+        return false;
+    }
+
+    SearchRandom random(options.seed);
+    SearchRandom *tie_breaker = options.restarts == RestartPolicy::NONE ? nullptr : &random;
+    unsigned long long run_limit = restartLimit(options, 0);
+    unsigned long long run_nodes = 0;
+    bool propagating = options.propagate || options.matching;
+    matching = options.matching;
+    observer.onStart(side_length);
+
+    if (propagating && !propagate(observer)) {   // contradiction before any decision
+        observer.onConflict(0);
+        return false;
+    }
+
+    while (true) {
+        uint64_t mask = 0;
+        int cell = leastAmbiguousCell(mask, tie_breaker);
+        ++stats.nodes;
+
+        if (cell == -1) {                        // board is full
+            observer.onSolution((int) stack.size());
+            return true;
+        }
+
+        if ((stats.nodes & 0xff) == 0 && cancel_flag &&
+            cancel_flag->load(std::memory_order_relaxed)) {
+            cancelled = true;
+            return false;
+        }
+        if (options.node_limit != 0 && stats.nodes > options.node_limit) {
+            cancelled = true;
+            return false;
+        }
+
+        if (run_limit != 0 && ++run_nodes > run_limit) {   // run is over, back to the givens
+            undoTo(0);
+            stack.clear();
+            ++stats.restarts;
+            run_nodes = 0;
+            run_limit = restartLimit(options, (int) stats.restarts);
+
+            if (propagating) {
+                propagate(observer);             // succeeded before the first run already
+            }
+            continue;
+        }
+
+        if (mask != 0) {                         // branch on the chosen cell
+            Frame frame = {cell, mask, (int) trail.size(), hash, 0};
+            stack.push_back(frame);
+        }
+
+        // backtracks until a frame with an untried, non-contradictory value is found
+        while (true) {
+            if (stack.empty()) {
+                return false;
+            }
+
+            Frame &top = stack.back();
+            undoTo(top.trail_mark);
+
+            if (top.remaining == 0) {
+                stack.pop_back();
+                ++stats.backtracks;
+                observer.onBacktrack((int) stack.size());
+                continue;
+            }
+
+            int val = nextValue(top.cell, top.remaining, options.value_order, random);
+            assign(top.cell, val);
+            observer.onDecision((int) stack.size(), top.cell, val);
+
+            if (!propagating || propagate(observer)) {
+                break;
+            }
+            observer.onConflict((int) stack.size());
+        }
+    }
+}
+
+template bool SolverContext::solve<NullObserver>(const SearchOptions &, NullObserver &);
+template bool SolverContext::solve<BinaryTracer>(const SearchOptions &, BinaryTracer &);
+
+/**
+ * Counts the solutions of the armed puzzle, memoizing the count below every finished
+ * branch in a private transposition table that starts empty on each call.
+ *
+ * @param limit (stop once this many solutions are found, 0 = count them all)
+ * @return number of solutions, capped at limit
+ */
+unsigned long long SolverContext::countSolutions(unsigned long long limit) {
+    if (!own_table) {
+        own_table.reset(new TranspositionTable(14));
+    } else {
+        own_table->clear();
+    }
+
+    return countSolutions(limit, *own_table);
+}
+
+/**
+ * Counts the solutions of the armed puzzle with propagation and MRV, memoizing the
+ * count below every finished branch. The hash describes what is left to solve (which
+ * cells are filled and which values every unit already holds) rather than the values
+ * themselves, so boards that differ only by values swapped between filled cells, which
+ * different branches reach all the time, share one entry. Branches cut short by the
+ * limit are never stored, so the table only holds exact counts.
+ *
+ * The board is back to the givens when this returns.
+ *
+ * @param limit (stop once this many solutions are found, 0 = count them all)
+ * @param table (memo of subtree counts)
+ * @return number of solutions, capped at limit
+ */
+unsigned long long SolverContext::countSolutions(unsigned long long limit,
+                                                 TranspositionTable &table) {
+    cancelled = false;
+    matching = false;
+    stats = SearchStats();
+
+    if (!armed) {
+        return 0;
+    }
+
+    SearchRandom random;                         // unused by ascending order
+    unsigned long long found = 0;
+    bool searching = propagate();
+
+    while (searching) {
+        uint64_t mask = 0;
+        int cell = leastAmbiguousCell(mask, nullptr);
+        unsigned long long known = 0;
+        ++stats.nodes;
+
+        if ((stats.nodes & 0xff) == 0 && cancel_flag &&
+            cancel_flag->load(std::memory_order_relaxed)) {
+            cancelled = true;
+            break;
+        }
+
+        if (cell == -1) {                        // board is full: one solution
+            known = 1;
+        } else if (mask != 0 && !table.probe(hash, known)) {
+            Frame frame = {cell, mask, (int) trail.size(), hash, 0};
+            stack.push_back(frame);
+        }
+
+        found += known;
+        if (!stack.empty()) {
+            stack.back().count += known;
+        }
+
+        if (limit != 0 && found >= limit) {
+            break;
+        }
+
+        // backtracks until a frame with an untried, non-contradictory value is found;
+        // finished frames store their count and hand it to their parent
+        while (true) {
+            if (stack.empty()) {
+                searching = false;
+                break;
+            }
+
+            Frame &top = stack.back();
+            undoTo(top.trail_mark);
+
+            if (top.remaining == 0) {
+                unsigned long long count = top.count;
+                table.store(top.hash, count);
+                stack.pop_back();
+                ++stats.backtracks;
+
+                if (!stack.empty()) {
+                    stack.back().count += count;
+                }
+                continue;
+            }
+
+            assign(top.cell, nextValue(top.cell, top.remaining, ValueOrder::ASCENDING, random));
+
+            if (propagate()) {
+                break;
+            }
+        }
+    }
+
+    undoTo(0);
+    stack.clear();
+
+    return limit != 0 && found > limit ? limit : found;
+}
+
+/**
+ * Registers a flag that aborts the search once it becomes true. The flag is polled
+ * every few hundred nodes, so a cancelled search stops almost immediately.
+ *
+ * @param flag (shared flag, or nullptr to run uncancellable)
+ */
+void SolverContext::setCancelFlag(const std::atomic<bool> *flag) {
+    cancel_flag = flag;
+}
+
+/**
+ * @return true if the last solve stopped because its cancel flag was raised or its
+ * node limit ran out
+ */
+bool SolverContext::wasCancelled() const {
+    return cancelled;
+}
+
+/**
+ * Copies the current board into a caller-owned buffer
+ *
+ * @param cells (buffer of at least side_length * side_length values)
+ */
+void SolverContext::storeCells(uint8_t *cells) const {
+    if (cell_count > 0) {
+        std::memcpy(cells, board.data(), (std::size_t) cell_count);
+    }
+}
+
+/**
+ * @return number of rows and cols on the armed board
+ */
+int SolverContext::getSideLength() const {
+    return side_length;
+}
+
+/**
+ * @return number of search nodes expanded by the last solve
+ */
+unsigned long long SolverContext::getNodeCount() const {
+    return stats.nodes;
+}
+
+/**
+ * @return node, backtrack and value-order stats of the last solve
+ */
+const SearchStats &SolverContext::getStats() const {
+    return stats;
+}
+
+/**
+ * @return bitmask of values that can still be placed on the cell
+ */
+uint64_t SolverContext::candidates(int cell) const {
+    const int *units = model->cellUnits(cell);
+    uint64_t used = 0;
+
+    for (int x = model->cellUnitCount(cell) - 1; x >= 0; --x) {
+        used |= unit_used[units[x]];
+    }
+
+    return full_mask & ~used & ~pruned[cell];
+}
+
+/**
+ * Places a value on the cell and records it on the trail
+ */
+void SolverContext::assign(int cell, int val) {
+    const int *units = model->cellUnits(cell);
+    uint64_t bit = 1ull << (val - 1);
+
+    for (int x = model->cellUnitCount(cell) - 1; x >= 0; --x) {
+        unit_used[units[x]] |= bit;
+        hash ^= zobrist[cell_count + units[x] * side_length + val - 1];
+    }
+
+    board[cell] = (uint8_t) val;
+    ++placed_count[val];
+    hash ^= zobrist[cell];
+    trail.push_back(cell);
+}
+
+/**
+ * Removes candidates from an empty cell and records it on the trail
+ */
+void SolverContext::pruneCell(int cell, uint64_t mask) {
+    pruned_trail.push_back(pruned[cell]);
+    pruned[cell] |= mask;
+    trail.push_back(~cell);
+}
+
+/**
+ * Undoes trail entries until the trail is back to the given length
+ */
+void SolverContext::undoTo(int trail_mark) {
+    while ((int) trail.size() > trail_mark) {
+        int cell = trail.back();
+
+        if (cell < 0) {                          // a pruneCell entry
+            pruned[~cell] = pruned_trail.back();
+            pruned_trail.pop_back();
+            trail.pop_back();
+            continue;
+        }
+        const int *units = model->cellUnits(cell);
+        uint64_t bit = ~(1ull << (board[cell] - 1));
+
+        for (int x = model->cellUnitCount(cell) - 1; x >= 0; --x) {
+            unit_used[units[x]] &= bit;
+            hash ^= zobrist[cell_count + units[x] * side_length + board[cell] - 1];
+        }
+
+        --placed_count[board[cell]];
+        hash ^= zobrist[cell];
+        board[cell] = 0;
+        trail.pop_back();
+    }
+}
+
+/**
+ * Places every naked single (cell with one candidate) and hidden single (value with one
+ * possible cell in a unit) until none are left. Placements go on the trail so the
+ * caller's undoTo removes them along with the decision.
+ *
+ * @return false if some cell or unit can no longer be completed
+ */
+bool SolverContext::propagate() {
+    NullObserver observer;
+    return propagate(observer);
+}
+
+/**
+ * propagate() reporting each forced placement to an observer
+ */
+template<typename Observer>
+bool SolverContext::propagate(Observer &observer) {
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        for (int cell = 0; cell < cell_count; ++cell) {
+            if (board[cell] != 0) {
+                continue;
+            }
+
+            uint64_t mask = candidates(cell);
+            if (mask == 0) {                     // cell has nothing left to hold
+                return false;
+            }
+            if ((mask & (mask - 1)) == 0) {      // naked single
+                int val = lowestValue(mask) + 1;
+                assign(cell, val);
+                observer.onPropagation((int) stack.size(), cell, val);
+                changed = true;
+            }
+        }
+
+        for (int unit = 0; unit < model->getUnitCount(); ++unit) {
+            const int *cells = model->unitCells(unit);
+            int size = model->unitSize(unit);
+            uint64_t once = 0;
+            uint64_t twice = 0;
+
+            for (int x = 0; x < size; ++x) {
+                if (board[cells[x]] == 0) {
+                    uint64_t mask = candidates(cells[x]);
+                    twice |= once & mask;
+                    once |= mask;
+                }
+            }
+
+            // a complete unit must still have room for every value it has not placed
+            if (size == side_length && (once | unit_used[unit]) != full_mask) {
+                return false;
+            }
+
+            if (size != side_length) {               // hidden singles need a complete unit
+                continue;
+            }
+
+            for (uint64_t singles = once & ~twice; singles; singles &= singles - 1) {
+                uint64_t bit = singles & (~singles + 1);
+
+                for (int x = 0; x < size; ++x) {
+                    if (board[cells[x]] == 0 && (candidates(cells[x]) & bit)) {
+                        int val = lowestValue(bit) + 1;
+                        assign(cells[x], val);
+                        observer.onPropagation((int) stack.size(), cells[x], val);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // the costlier matching filter only runs once singles have nothing left to place
+        if (matching && !changed) {
+            for (int unit = 0; unit < model->getUnitCount(); ++unit) {
+                if (!filterUnit(unit, changed)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Matching-based all-different filtering (Regin) of one unit. A complete matching pairs
+ * every empty cell of the unit with a distinct candidate value; a candidate survives
+ * only if some complete matching uses it. With one matching M in hand that holds for
+ * the values M gives the cells, for values reachable from a value M leaves free (swap
+ * along the alternating path), and for values on an alternating cycle, i.e. held by a
+ * cell in the same strongly connected component of the graph "cell u -> every other
+ * cell that could take u's matched value". Cells and values fit in one 64-bit mask
+ * each, so the graph and its components are bitmask operations.
+ *
+ * @param changed (set to true if a candidate was removed)
+ * @return false if the empty cells cannot all get distinct values
+ */
+bool SolverContext::filterUnit(int unit, bool &changed) {
+    const int *cells = model->unitCells(unit);
+    int size = model->unitSize(unit);
+    int vars[64];                                // empty cells of the unit
+    uint64_t domain[64];                         // their candidates
+    int mate[64];                                // value matched to each var
+    int owner[64];                               // var matched to each value, -1 if free
+    int var_count = 0;
+
+    if (size > 64) {
+        return true;
+    }
+    for (int x = 0; x < size; ++x) {
+        if (board[cells[x]] == 0) {
+            vars[var_count] = cells[x];
+            domain[var_count++] = candidates(cells[x]);
+        }
+    }
+    if (var_count == 0) {
+        return true;
+    }
+    std::fill(owner, owner + side_length, -1);
+    std::fill(mate, mate + var_count, -1);       // the path flip reads the start's mate
+
+    // maximum matching: each var in turn, by a breadth-first augmenting path search
+    for (int start = 0; start < var_count; ++start) {
+        int queue[64];
+        int via[64];                             // var that reached each value
+        int head = 0;
+        int tail = 0;
+        int found = -1;
+        uint64_t seen = 0;
+        queue[tail++] = start;
+
+        while (head < tail && found < 0) {
+            int var = queue[head++];
+
+            for (uint64_t rest = domain[var] & ~seen; rest; rest &= rest - 1) {
+                int val = lowestValue(rest);
+                seen |= 1ull << val;
+                via[val] = var;
+                if (owner[val] < 0) {
+                    found = val;
+                    break;
+                }
+                queue[tail++] = owner[val];
+            }
+        }
+
+        if (found < 0) {                         // Hall violation: too few values left
+            return false;
+        }
+
+        for (int val = found; ; ) {              // flips the path back to start
+            int var = via[val];
+            int next = mate[var];
+            mate[var] = val;
+            owner[val] = var;
+            if (var == start) {
+                break;
+            }
+            val = next;
+        }
+    }
+
+    uint64_t holders[64];                        // vars that could take each value
+    uint64_t free_values = 0;
+    std::fill(holders, holders + side_length, 0);
+    for (int var = 0; var < var_count; ++var) {
+        for (uint64_t rest = domain[var]; rest; rest &= rest - 1) {
+            holders[lowestValue(rest)] |= 1ull << var;
+        }
+        free_values |= domain[var];
+    }
+    for (int var = 0; var < var_count; ++var) {
+        free_values &= ~(1ull << mate[var]);
+    }
+
+    uint64_t succ[64];                           // edges of the var graph
+    for (int var = 0; var < var_count; ++var) {
+        succ[var] = holders[mate[var]] & ~(1ull << var);
+    }
+
+    // vars an alternating path from a free value reaches, and the values they hold
+    uint64_t reached = 0;
+    for (uint64_t rest = free_values; rest; rest &= rest - 1) {
+        reached |= holders[lowestValue(rest)];
+    }
+    for (uint64_t frontier = reached; frontier; ) {
+        int var = lowestValue(frontier);
+        frontier &= frontier - 1;
+        frontier |= succ[var] & ~reached;
+        reached |= succ[var];
+    }
+    uint64_t reachable_values = free_values;
+    for (uint64_t rest = reached; rest; rest &= rest - 1) {
+        reachable_values |= 1ull << mate[lowestValue(rest)];
+    }
+
+    uint64_t closure[64];                        // vars reachable from each var
+    for (int var = 0; var < var_count; ++var) {
+        uint64_t seen = succ[var];
+        for (uint64_t frontier = seen; frontier; ) {
+            int next = lowestValue(frontier);
+            frontier &= frontier - 1;
+            frontier |= succ[next] & ~seen;
+            seen |= succ[next];
+        }
+        closure[var] = seen;
+    }
+
+    for (int var = 0; var < var_count; ++var) {
+        uint64_t allowed = (1ull << mate[var]) | (domain[var] & reachable_values);
+
+        for (uint64_t rest = closure[var]; rest; rest &= rest - 1) {
+            int other = lowestValue(rest);
+            if (closure[other] & (1ull << var)) {     // same component: a cycle
+                allowed |= 1ull << mate[other];
+            }
+        }
+
+        uint64_t removed = domain[var] & ~allowed;
+        if (removed) {
+            pruneCell(vars[var], removed);
+            stats.pruned += countValues(removed);
+            changed = true;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Picks the next value to try out of a frame's remaining candidates according to the
+ * value order, and removes it from remaining.
+ *
+ * LEAST_CONSTRAINING scores each value by how many empty peers of the cell still have it
+ * as a candidate; FREQUENCY scores it by how often it is already placed. Ties go to the
+ * lower value.
+ *
+ * @return value (1-based) to place
+ */
+int SolverContext::nextValue(int cell, uint64_t &remaining, ValueOrder order,
+                             SearchRandom &random) const {
+    uint64_t bit = remaining & (~remaining + 1);
+
+    if (order == ValueOrder::RANDOM) {
+        uint64_t pick = remaining;
+        for (uint64_t skip = random.below((uint32_t) countValues(remaining)); skip; --skip) {
+            pick &= pick - 1;
+        }
+        bit = pick & (~pick + 1);
+    } else if (order == ValueOrder::LEAST_CONSTRAINING) {
+        const int *peers = model->peers(cell);
+        int peer_count = model->peerCount(cell);
+        int best_score = peer_count + 1;
+
+        for (uint64_t rest = remaining; rest; rest &= rest - 1) {
+            uint64_t curr = rest & (~rest + 1);
+            int score = 0;
+
+            for (int x = 0; x < peer_count; ++x) {
+                if (board[peers[x]] == 0 && (candidates(peers[x]) & curr)) {
+                    ++score;
+                }
+            }
+
+            if (score < best_score) {
+                best_score = score;
+                bit = curr;
+            }
+        }
+    } else if (order == ValueOrder::FREQUENCY) {
+        int best_score = -1;
+
+        for (uint64_t rest = remaining; rest; rest &= rest - 1) {
+            uint64_t curr = rest & (~rest + 1);
+            int score = placed_count[lowestValue(curr) + 1];
+
+            if (score > best_score) {
+                best_score = score;
+                bit = curr;
+            }
+        }
+    }
+
+    remaining &= ~bit;
+    return lowestValue(bit) + 1;
+}
+
+/**
+ * Finds the empty cell with the fewest candidates. Stops early on a cell with zero or
+ * one candidates since nothing can beat it.
+ *
+ * @param mask (filled with the candidates of the chosen cell)
+ * @param random (picks uniformly among tied cells, or nullptr to take the first)
+ * @return chosen cell, or -1 if the board is full
+ */
+int SolverContext::leastAmbiguousCell(uint64_t &mask, SearchRandom *random) const {
+    int best_cell = -1;
+    int min_value = side_length + 1;
+    uint32_t ties = 1;                           // cells seen with the current minimum
+
+    for (int cell = 0; cell < cell_count; ++cell) {
+        if (board[cell] != 0) {
+            continue;
+        }
+
+        uint64_t curr_mask = candidates(cell);
+        int curr_value = countValues(curr_mask);
+
+        if (curr_value < min_value) {
+            min_value = curr_value;
+            best_cell = cell;
+            mask = curr_mask;
+            ties = 1;
+
+            if (curr_value <= 1) {
+                break;
+            }
+        } else if (random && curr_value == min_value && random->below(++ties) == 0) {
+            best_cell = cell;                    // reservoir sampling over the ties
+            mask = curr_mask;
+        }
+    }
+
+    return best_cell;
+}
+
+/**
+ * RAII handle on a pooled context; on destruction the context goes to the pool of the
+ * thread destroying the lease, so a lease should end on the thread that took it
+ */
+SolverPool::Lease::Lease(std::unique_ptr<SolverContext> context)
+        : context(std::move(context)) {
+}
+
+SolverPool::Lease::Lease(Lease &&other) : context(std::move(other.context)) {
+}
+
+SolverPool::Lease::~Lease() {
+    if (context) {
+        freeList().push_back(std::move(context));
+    }
+}
+
+SolverContext &SolverPool::Lease::operator*() const {
+    return *context;
+}
+
+SolverContext *SolverPool::Lease::operator->() const {
+    return context.get();
+}
+
+/**
+ * @return a context from the calling thread's pool, created if the pool is empty
+ */
+SolverPool::Lease SolverPool::acquire() {
+    std::vector<std::unique_ptr<SolverContext>> &pool = freeList();
+
+    if (pool.empty()) {
+        return Lease(std::unique_ptr<SolverContext>(new SolverContext()));
+    }
+
+    std::unique_ptr<SolverContext> context = std::move(pool.back());
+    pool.pop_back();
+    return Lease(std::move(context));
+}
+
+/**
+ * @return the calling thread's lockstep engine, created on first use; it lives as long as
+ * the thread does and, like a leased context, serves one batch at a time
+ */
+LockstepBatch &SolverPool::lockstep() {
+    static thread_local std::unique_ptr<LockstepBatch> batch;
+    if (!batch) {
+        batch.reset(new LockstepBatch());
+    }
+    return *batch;
+}
+
+/**
+ * @return the calling thread's free list; contexts live as long as the thread does
+ */
+std::vector<std::unique_ptr<SolverContext>> &SolverPool::freeList() {
+    static thread_local std::vector<std::unique_ptr<SolverContext>> pool;
+    return pool;
+}
+
+/**
+ * Solves one puzzle of a batch on a context. With a profile, the wall time from arming
+ * to storing the result is recorded in nanoseconds, along with the nodes searched.
+ *
+ * @param puzzle (side_length * side_length values, row-major)
+ * @param solution (set to the solution, or to the puzzle as given if it has none)
+ * @param profile (per-thread profile to record into, or nullptr)
+ * @return true if the puzzle was solved
+ */
+bool solveOne(SolverContext &context, const uint8_t *puzzle, int side_length,
+              uint8_t *solution, SolveProfile *profile) {
+    std::chrono::steady_clock::time_point start;
+    if (profile) {
+        start = std::chrono::steady_clock::now();
+    }
+
+    bool armed = context.arm(puzzle, side_length);
+    bool solved = armed && context.solve(SearchOptions::forSide(side_length));
+    if (solved) {
+        context.storeCells(solution);
+    } else {
+        std::memcpy(solution, puzzle, (std::size_t) side_length * side_length);
+    }
+
+    if (profile) {
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+        profile->latency.record((uint64_t) elapsed.count());
+        profile->nodes.record(armed ? context.getNodeCount() : 0);
+    }
+    return solved;
+}
+
+/**
+ * Solves a batch of same-size puzzles with a pooled context; 9 x 9 batches go through
+ * LockstepBatch, which only searches the boards propagation leaves open.
+ *
+ * @param puzzles (count boards of side_length * side_length values, back to back)
+ * @param solutions (output buffer of the same layout; unsolvable boards are left as given)
+ * @param count (number of boards)
+ * @param side_length (number of rows and cols on every board)
+ * @param profile (profile owned by the calling thread to record every solve into, or
+ * nullptr)
+ * @return number of boards solved
+ */
+std::size_t solveBatch(const uint8_t *puzzles, uint8_t *solutions, std::size_t count,
+                       int side_length, SolveProfile *profile) {
+    SolverPool::Lease context = SolverPool::acquire();
+    if (side_length == LockstepBatch::SIDE) {
+        return SolverPool::lockstep().solve(*context, puzzles, solutions, count, nullptr,
+                                            profile);
+    }
+
+    std::size_t cells = (std::size_t) side_length * side_length;
+    std::size_t solved = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        solved += solveOne(*context, puzzles + i * cells, side_length, solutions + i * cells,
+                           profile);
+    }
+
+    return solved;
+}
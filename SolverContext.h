@@ -0,0 +1,311 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef SOLVER_CONTEXT_H
+#define SOLVER_CONTEXT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Histogram.h"
+#include "RegionModel.h"
+#include "SearchObserver.h"
+#include "SearchOptions.h"
+#include "TranspositionTable.h"
+
+class LockstepBatch;
+
+/**
+ * Reusable solving state for batch work. A context owns every buffer the search needs
+ * (flat board, per-unit masks, placement trail and decision stack) and is re-armed in
+ * place from each new puzzle, so once its buffers have grown to the largest board seen
+ * no further allocation happens per puzzle. Constraints come from a RegionModel, so
+ * variant grids run through the same search as standard ones.
+ */
+class SolverContext {
+
+public:
+    /**
+     * constructs an empty context; buffers are sized on the first call to arm
+     */
+    SolverContext();
+
+    /**
+    * Re-arms the context with a new puzzle on a standard board, reusing the existing
+    * buffers when the board size has not grown.
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param side_length (number of rows and cols on the board, must be a square number)
+    * @return false if the puzzle is malformed or its givens already conflict
+    */
+    bool arm(const uint8_t *cells, int side_length);
+
+    /**
+    * Re-arms the context with a new puzzle constrained by a region model (diagonals,
+    * windows, jigsaw regions, ...). The model is referenced, not copied.
+    *
+    * @param cells (side_length * side_length values in row-major order, 0 for empty)
+    * @param regions (constraint model; must outlive every solve on this puzzle)
+    * @return false if the puzzle is malformed or its givens already conflict
+    */
+    bool arm(const uint8_t *cells, const RegionModel &regions);
+
+    /**
+    * Solves the armed puzzle with an iterative minimum-remaining-values search,
+    * restarting from the root on the schedule in options.restarts.
+    *
+    * @param options (propagation, value-order and restart settings for this search)
+    * @return true if a solution exists, false if not or if the search was cancelled
+    */
+    bool solve(const SearchOptions &options = SearchOptions());
+
+    /**
+    * Solves the armed puzzle like solve(options), reporting every decision, forced
+    * placement, conflict, backtrack and solution to an observer (see SearchObserver.h).
+    * The observer is a template argument, so its hooks are inlined and the plain solve,
+    * which runs with NullObserver, pays nothing for them. Instantiated for NullObserver
+    * and BinaryTracer; another observer needs its own instantiation in SolverContext.cpp.
+    *
+    * @param options (propagation, value-order and restart settings for this search)
+    * @param observer (receives the search events)
+    * @return true if a solution exists, false if not or if the search was cancelled
+    */
+    template<typename Observer>
+    bool solve(const SearchOptions &options, Observer &observer);
+
+    /**
+    * Counts the solutions of the armed puzzle, memoizing the count below every finished
+    * branch in a private transposition table that starts empty on each call.
+    *
+    * @param limit (stop once this many solutions are found, 0 = count them all)
+    * @return number of solutions, capped at limit
+    */
+    unsigned long long countSolutions(unsigned long long limit = 0);
+
+    /**
+    * Counts the solutions of the armed puzzle, memoizing the count below every finished
+    * branch in a caller-owned table. The table may be shared with other threads and
+    * other puzzles, as long as they all use the same constraint model.
+    *
+    * @param limit (stop once this many solutions are found, 0 = count them all)
+    * @param table (memo of subtree counts)
+    * @return number of solutions, capped at limit
+    */
+    unsigned long long countSolutions(unsigned long long limit, TranspositionTable &table);
+
+    /**
+    * Registers a flag that aborts the search once it becomes true. The flag is polled
+    * every few hundred nodes, so a cancelled search stops almost immediately.
+    *
+    * @param flag (shared flag, or nullptr to run uncancellable)
+    */
+    void setCancelFlag(const std::atomic<bool> *flag);
+
+    /**
+    * @return true if the last solve stopped because its cancel flag was raised or its
+    * node limit ran out
+    */
+    bool wasCancelled() const;
+
+    /**
+    * Copies the current board into a caller-owned buffer
+    *
+    * @param cells (buffer of at least side_length * side_length values)
+    */
+    void storeCells(uint8_t *cells) const;
+
+    /**
+    * @return number of rows and cols on the armed board
+    */
+    int getSideLength() const;
+
+    /**
+    * @return number of search nodes expanded by the last solve
+    */
+    unsigned long long getNodeCount() const;
+
+    /**
+    * @return node, backtrack and value-order stats of the last solve
+    */
+    const SearchStats &getStats() const;
+
+private:
+
+    /**
+     * One decision on the explicit search stack: the cell being branched on, the
+     * candidates not yet tried, and the trail length to undo back to. Counting also
+     * keeps the board hash before the decision and the solutions found below it.
+     */
+    struct Frame {
+        int cell;
+        uint64_t remaining;
+        int trail_mark;
+        uint64_t hash;
+        unsigned long long count;
+    };
+
+    int side_length;  // number of rows and cols on the board
+    int cell_count;   // side_length * side_length
+    bool armed;       // false if the last arm call was rejected
+    bool cancelled;   // true if the last solve was aborted through cancel_flag or node_limit
+    bool matching;    // propagate also runs filterUnit, set from the solve options
+    uint64_t full_mask;             // bit (v - 1) set for every value 1..side_length
+    SearchStats stats;              // counters of the last solve
+    const std::atomic<bool> *cancel_flag;  // polled during search, may be nullptr
+
+    RegionModel standard_model;      // rows/cols/boxes model used by arm(cells, side)
+    const RegionModel *model;        // constraint model of the armed puzzle
+
+    std::vector<uint8_t> board;      // flat row-major board, 0 for empty
+    std::vector<uint64_t> unit_used; // values in use per unit of the model
+    std::vector<int> placed_count;   // times each value is placed on the board
+    std::vector<int> trail;          // cells assigned by the search, in order, and ~cell
+                                     // for each pruneCell
+    std::vector<uint64_t> pruned;    // candidates removed per cell by filterUnit
+    std::vector<uint64_t> pruned_trail;  // pruned masks overwritten, one per ~cell entry
+    std::vector<Frame> stack;        // decision stack
+
+    uint64_t hash;                   // Zobrist hash of the filled cells and unit_used,
+                                     // kept by assign / undoTo
+    std::vector<uint64_t> zobrist;   // random key of each cell and each (unit, value)
+    std::unique_ptr<TranspositionTable> own_table;   // memo of countSolutions(limit)
+
+    /**
+    * @return bitmask of values that can still be placed on the cell
+    */
+    uint64_t candidates(int cell) const;
+
+    /**
+    * Places a value on the cell and records it on the trail
+    */
+    void assign(int cell, int val);
+
+    /**
+    * Removes candidates from an empty cell and records it on the trail
+    */
+    void pruneCell(int cell, uint64_t mask);
+
+    /**
+    * Undoes trail entries until the trail is back to the given length
+    */
+    void undoTo(int trail_mark);
+
+    /**
+    * Matching-based all-different filtering (Regin) of one unit: removes every
+    * candidate that no complete matching of the unit's empty cells to distinct values
+    * uses.
+    *
+    * @param changed (set to true if a candidate was removed)
+    * @return false if the empty cells cannot all get distinct values
+    */
+    bool filterUnit(int unit, bool &changed);
+
+    /**
+    * Places every naked single and hidden single until none are left, then, when
+    * matching is on, filters every unit and starts over while that removes anything.
+    * Placements go on the trail so the caller's undoTo removes them along with the
+    * decision.
+    *
+    * @return false if some cell or unit can no longer be completed
+    */
+    bool propagate();
+
+    /**
+    * propagate() reporting each forced placement to an observer
+    */
+    template<typename Observer>
+    bool propagate(Observer &observer);
+
+    /**
+    * Picks the next value to try out of a frame's remaining candidates according to the
+    * value order, and removes it from remaining.
+    *
+    * @return value (1-based) to place
+    */
+    int nextValue(int cell, uint64_t &remaining, ValueOrder order, SearchRandom &random) const;
+
+    /**
+    * Finds the empty cell with the fewest candidates.
+    *
+    * @param mask (filled with the candidates of the chosen cell)
+    * @param random (picks uniformly among tied cells, or nullptr to take the first)
+    * @return chosen cell, or -1 if the board is full
+    */
+    int leastAmbiguousCell(uint64_t &mask, SearchRandom *random) const;
+};
+
+/**
+ * Per-thread pool of solver contexts. Contexts are handed out through a Lease and go
+ * back to the calling thread's free list when the lease ends, so a worker solving many
+ * puzzles keeps hitting the same warm buffers.
+ */
+class SolverPool {
+
+public:
+    /**
+     * RAII handle on a pooled context; on destruction the context goes to the pool of
+     * the thread destroying the lease, so a lease should end on the thread that took it
+     */
+    class Lease {
+
+    public:
+        explicit Lease(std::unique_ptr<SolverContext> context);
+        Lease(Lease &&other);
+        ~Lease();
+
+        SolverContext &operator*() const;
+        SolverContext *operator->() const;
+
+    private:
+        std::unique_ptr<SolverContext> context;
+
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+    };
+
+    /**
+    * @return a context from the calling thread's pool, created if the pool is empty
+    */
+    static Lease acquire();
+
+    /**
+    * @return the calling thread's lockstep engine for 9 x 9 batches, created on first use
+    */
+    static LockstepBatch &lockstep();
+
+private:
+    static std::vector<std::unique_ptr<SolverContext>> &freeList();
+};
+
+/**
+ * Solves one puzzle of a batch on a context, optionally timing it
+ *
+ * @param puzzle (side_length * side_length values, row-major)
+ * @param solution (set to the solution, or to the puzzle as given if it has none)
+ * @param profile (per-thread profile the solve time and node count are recorded into,
+ * or nullptr)
+ * @return true if the puzzle was solved
+ */
+bool solveOne(SolverContext &context, const uint8_t *puzzle, int side_length,
+              uint8_t *solution, SolveProfile *profile = nullptr);
+
+/**
+ * Solves a batch of same-size puzzles with a pooled context; 9 x 9 batches go through
+ * LockstepBatch, which only searches the boards propagation leaves open.
+ *
+ * @param puzzles (count boards of side_length * side_length values, back to back)
+ * @param solutions (output buffer of the same layout; unsolvable boards are left as given)
+ * @param count (number of boards)
+ * @param side_length (number of rows and cols on every board)
+ * @param profile (profile owned by the calling thread to record every solve into, or
+ * nullptr)
+ * @return number of boards solved
+ */
+std::size_t solveBatch(const uint8_t *puzzles, uint8_t *solutions, std::size_t count,
+                       int side_length, SolveProfile *profile = nullptr);
+
+#endif // ends SOLVER_CONTEXT_H
@@ -4,17 +4,106 @@
  *************************************************************************************/
 
 #include "Sudoku.h"
+#include "SatSudoku.h"
+#include "SolverContext.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 
+namespace {
+
+const uint64_t SEARCH_MAGIC = 0x32686372616553ull;  //"Search2", first word of a saved search
+const int SIDE_MAX = 64;                            //widest board the 64-bit value masks cover
+
+/**
+ * Appends a 64-bit word to a saved search, low byte first, so checkpoints move between
+ * machines
+ */
+void putWord(std::vector<uint8_t> &state, uint64_t word) {
+    for (int x = 0; x < 8; ++x) {
+        state.push_back((uint8_t) (word >> (8 * x)));
+    }
+}
+
+/**
+ * Reads back the words and bytes of a saved search. Reading past the end yields zeros
+ * and marks the reader as failed instead of overrunning.
+ */
+class StateReader {
+
+public:
+    explicit StateReader(const std::vector<uint8_t> &state) : state(state), pos(0),
+                                                              failed(false) {
+    }
+
+    uint64_t word() {
+        if (state.size() - pos < 8) {
+            failed = true;
+            return 0;
+        }
+
+        uint64_t word = 0;
+        for (int x = 0; x < 8; ++x) {
+            word |= (uint64_t) state[pos++] << (8 * x);
+        }
+        return word;
+    }
+
+    uint8_t byte() {
+        if (pos == state.size()) {
+            failed = true;
+            return 0;
+        }
+        return state[pos++];
+    }
+
+    /**
+    * @return a word that must be at most limit, failing the reader if it is not
+    */
+    int bounded(uint64_t limit) {
+        uint64_t value = word();
+        failed |= value > limit;
+        return failed ? 0 : (int) value;
+    }
+
+    /**
+    * @return true if every read so far succeeded and all data was consumed
+    */
+    bool complete() const {
+        return !failed && pos == state.size();
+    }
+
+    bool good() const {
+        return !failed;
+    }
+
+    /**
+    * Marks the data as invalid
+    */
+    void fail() {
+        failed = true;
+    }
+
+private:
+    const std::vector<uint8_t> &state;
+    std::size_t pos;
+    bool failed;
+};
+
+} // namespace
+
 /**
  * default constructor that assumes a 9 x 9 board filled with zeroes
  * Sudoku object can read in a board from a file, solve its current board, as well
  * as print out the board
  */
-Sudoku::Sudoku() : side_length(9), box_size(3), fill_counter(0) {
+Sudoku::Sudoku() : side_length(9), box_size(3), fill_counter(0), standard_regions(false),
+                   value_order(ValueOrder::ASCENDING), backjumping(true), depth(0),
+                   dead_cell(-1), conflict_words(0), branch_result(BRANCH_FAILED),
+                   search_status(SearchStatus::IDLE), live_state(false), conflicts(0),
+                   mismatches(0), known_unsolvable(false) {
     reset();
 }
 
@@ -29,8 +118,7 @@ void Sudoku::loadFromFile(std::string filename) {
     std::ifstream file(filename.c_str());
     std::string str;
 
-    SudoBoard.clear();              // clears array and resets board size value
-    side_length = 0;
+    side_length = 0;                // resets board size value, rows are reused below
     fill_counter = 0;
 
     if (!file) { // exit if unable to find file
@@ -41,66 +129,451 @@ void Sudoku::loadFromFile(std::string filename) {
     }
 
     while (std::getline(file, str)) {
-        std::vector<int> tmp;              // stores each row in tmp
+        if (side_length == (int) SudoBoard.size()) {   // only grows on a larger board
+            SudoBoard.emplace_back();
+        }
+
+        std::vector<int> &tmp = SudoBoard[side_length]; // refills each row in place
+        tmp.clear();
+
+        // a line with spaces holds one value per token, so boards over 9 x 9 can use
+        // several digits per square; otherwise every character is a square
+        bool tokens = str.find(' ') != std::string::npos;
+        int val = -1;                                   // value of the token being read
 
         for (char x : str) {
-            if (x != ' ') {
+            if (x == ' ') {
+                if (val >= 0) {
+                    tmp.push_back(val);
+                }
+                val = -1;
+            } else if (tokens) {
+                val = (val < 0 ? 0 : val * 10) + (x - '0');
+            } else {
                 tmp.push_back(x - '0');
             }
         }
+        if (val >= 0) {
+            tmp.push_back(val);
+        }
 
-        SudoBoard.push_back(tmp);                //pushes each row to 2D vector
-        tmp.clear();
         side_length++;
     }
 
+    SudoBoard.resize(side_length);               //drops rows left over from a larger board
+
     box_size = (int) (sqrt(side_length));        //assigns Sudoku "box" sizes
+    if (box_size * box_size != side_length || side_length > SIDE_MAX) {
+        reset();                                 //no square boxes, or too wide for the masks
+        return;
+    }
+    live_state = false;
+    search_status = SearchStatus::IDLE;
+    useStandardRegions();
 }
 
 /**
  * Prints out the Sudoku board
  */
 void Sudoku::print() const {
+    std::vector<char> text(formattedSize(side_length, GridStyle::PRETTY));
+    std::cout.write(text.data(), (std::streamsize) format(text.data(), GridStyle::PRETTY));
+}
 
-    if (side_length == 9) {                        //print format for 9 x 9
-        for (int x = 0; x < side_length; ++x) {
-            for (int y = 0; y < side_length; ++y) {
-                if (y % 3 == 0 && y != 0 && y != side_length) {
-                    std::cout << "| ";
-                }
-                std::cout << SudoBoard[x][y] << " ";
-            }
+/**
+ * Solves Sudoku board by getting first open square, then calling place on this
+ * open
+ * square. Actively modifies the existing board.
+ *
+ * @return true if solution exists, false if not solution exists
+ */
+bool Sudoku::solve() {
+    return solve(ValueOrder::ASCENDING);
+}
 
-            if ((x + 1) % 3 == 0 && x != side_length - 1 && x != 0) {
-                std::cout << std::endl;
-                std::cout << "------+-------+------";
+/**
+ * Solves the board with SatSudoku's clause-learning search, which on boards of 25 x 25
+ * and up is often far faster than solve(). The search runs to the end in one call: it
+ * records no node stats and cannot be suspended, so long solves that need checkpoints
+ * should use beginSearch/continueSearch instead. The search bookkeeping is reset to that
+ * of a finished search at depth 0, so saveSearch records the result.
+ *
+ * @return true if solution exists, false if no solution exists or the board is wider
+ * than 64
+ */
+bool Sudoku::solveSat() {
+    std::vector<uint8_t> cells(side_length * side_length);
+    storeCells(cells.data());
+
+    SatSudoku sat;
+    bool solved = sat.arm(cells.data(), regions) && sat.solve();
+    sat.storeCells(cells.data());
+    for (int x = 0; x < side_length; ++x) {
+        SudoBoard[x].assign(cells.begin() + x * side_length,
+                            cells.begin() + (x + 1) * side_length);
+    }
+
+    int cell_count = side_length * side_length;
+    stats = SearchStats();
+    live_state = false;
+    depth = 0;
+    conflict_words = cell_count / 64 + 1;
+    cell_levels.assign(cell_count, 0);
+    conflict.assign(conflict_words, 0);
+    search_status = solved ? SearchStatus::SOLVED : SearchStatus::UNSOLVABLE;
+    return solved;
+}
+
+/**
+ * Solves the Sudoku board like solve(), trying the candidates of each square picked by
+ * smartPlace in the given order. The order used is reported in getStats().
+ *
+ * @param order (value-ordering policy for this call)
+ * @param seed (seed for ValueOrder::RANDOM, ignored otherwise)
+ * @return true if solution exists, false if not solution exists
+ */
+bool Sudoku::solve(ValueOrder order, uint64_t seed) {
+    beginSearch(order, seed);
+    return continueSearch() == SearchStatus::SOLVED;
+}
+
+/**
+ * Starts a resumable solve of the current board. Opening the first branch places
+ * nothing, so the board is unchanged until continueSearch runs.
+ *
+ * @param order (value-ordering policy for the search)
+ * @param seed (seed for ValueOrder::RANDOM, ignored otherwise)
+ * @param backjump (false to back up one level after every failure, as plain
+ * chronological backtracking does)
+ */
+void Sudoku::beginSearch(ValueOrder order, uint64_t seed, bool backjump) {
+    value_order = order;
+    backjumping = backjump;
+    random = SearchRandom(seed);
+    stats = SearchStats();
+    stats.value_order = order;
+    live_state = false;                 //the search rewrites the board
+
+    // one set of decision levels per level, with room for a placement on every square
+    int cell_count = side_length * side_length;
+    depth = 0;
+    fill_counter = 0;
+    conflict_words = cell_count / 64 + 1;
+    cell_levels.assign(cell_count, 0);
+    conflict_sets.assign((cell_count + 1) * conflict_words, 0);
+    conflict.assign(conflict_words, 0);
+    lowest_levels.resize(side_length + 1);
+    if ((int) frames.size() < cell_count + 1) {
+        frames.resize(cell_count + 1);
+    }
+
+    std::pair<int, int> firstOpenSquare = firstPass();
+    countPlaced();
+
+    branch_result = place(firstOpenSquare);
+    search_status = SearchStatus::SUSPENDED;
+}
+
+/**
+ * Runs the search as a loop over the decision stack. Each turn handles the outcome of
+ * the branch opened last: a failure is merged into the conflict set of the frame below
+ * (or pops that frame when the conflict does not involve it), then the frame on top
+ * tries its next value and opens the branch for the square after it. A frame out of
+ * values blames the placements that ruled out its untried values and pops.
+ *
+ * @param node_budget (values to place before suspending, 0 = no limit)
+ * @return SOLVED, UNSOLVABLE, or SUSPENDED if the budget ran out first
+ */
+SearchStatus Sudoku::continueSearch(unsigned long long node_budget) {
+    if (search_status != SearchStatus::SUSPENDED) {
+        return search_status;
+    }
+
+    unsigned long long node_limit = stats.nodes + node_budget;
+    live_state = false;
+
+    while (true) {
+        if (branch_result == BRANCH_SOLVED) {
+            search_status = SearchStatus::SOLVED;
+            return search_status;
+        }
+        if (depth == 0) {               //the failure reached the root
+            search_status = SearchStatus::UNSOLVABLE;
+            return search_status;
+        }
+
+        Frame &frame = frames[depth - 1];
+        std::pair<int, int> thisSquare = frame.square;
+
+        if (branch_result == BRANCH_FAILED && backjumping && !mergeConflict(depth)) {
+            // failure below does not involve this square: jump back past it
+            setSquare(thisSquare, 0);
+            --fill_counter;
+            --depth;
+            ++stats.backjumps;
+            continue;
+        }
+
+        if (node_budget != 0 && stats.nodes >= node_limit) {
+            branch_result = BRANCH_OPENED;  //the failure is merged; resume at the next value
+            return search_status;
+        }
+
+        int val = nextValue(frame);
+        if (val == 0) {
+            // blames the placements that ruled out the values never tried here as well
+            uint64_t *conflict_set = &conflict_sets[depth * conflict_words];
+            setSquare(thisSquare, 0);
+            addBlockers(thisSquare, conflict_set);
+            conflict.assign(conflict_set, conflict_set + conflict_words);
+            --depth;
+            --fill_counter;
+            ++stats.backtracks;
+            branch_result = BRANCH_FAILED;
+            continue;
+        }
+
+        setSquare(thisSquare, val);
+        ++stats.nodes;
+        branch_result = frame.sequential ? place(openSquare(thisSquare)) : smartPlace();
+    }
+}
+
+/**
+ * Serializes the search at its current node boundary: board, constraint model,
+ * decision stack with the values each branch has left, conflict sets, random state
+ * and stats. Restoring it with loadSearch, in this or another process, continues
+ * exactly the same search.
+ *
+ * @param state (replaced with the serialized search)
+ */
+void Sudoku::saveSearch(std::vector<uint8_t> &state) const {
+    int cell_count = side_length * side_length;
+    bool started = search_status != SearchStatus::IDLE;  //else the bookkeeping is stale
+    int saved_depth = started ? depth : 0;
+    state.clear();
+
+    putWord(state, SEARCH_MAGIC);
+    putWord(state, (uint64_t) side_length);
+    putWord(state, (uint64_t) fill_counter);
+    putWord(state, (uint64_t) saved_depth);
+    putWord(state, (uint64_t) search_status);
+    putWord(state, (uint64_t) branch_result);
+    putWord(state, (uint64_t) value_order);
+    putWord(state, backjumping);
+    putWord(state, random.getState());
+    putWord(state, stats.nodes);
+    putWord(state, stats.backtracks);
+    putWord(state, stats.backjumps);
+    putWord(state, stats.restarts);
+
+    for (int x = 0; x < side_length; ++x) {
+        for (int y = 0; y < side_length; ++y) {
+            state.push_back((uint8_t) SudoBoard[x][y]);
+        }
+    }
+
+    // squares emptied by backtracking may keep the level of a frame that is gone by now
+    for (int cell = 0; cell < cell_count; ++cell) {
+        bool live = started && cell_levels[cell] <= saved_depth;
+        putWord(state, live ? (uint64_t) cell_levels[cell] : 0);
+    }
+    for (int x = conflict_words; x < (saved_depth + 1) * conflict_words; ++x) {
+        putWord(state, conflict_sets[x]);            // rows of levels 1..depth
+    }
+    for (int x = 0; x < cell_count / 64 + 1; ++x) {
+        putWord(state, started ? conflict[x] : 0);
+    }
+
+    for (int level = 1; level <= saved_depth; ++level) {
+        const Frame &frame = frames[level - 1];
+        putWord(state, (uint64_t) (frame.square.first * side_length + frame.square.second));
+        putWord(state, frame.sequential);
+        putWord(state, (uint64_t) frame.next);
+        putWord(state, frame.sequential ? 0 : frame.values.size());
+        for (std::size_t x = 0; !frame.sequential && x < frame.values.size(); ++x) {
+            state.push_back((uint8_t) frame.values[x]);
+        }
+    }
+
+    putWord(state, standard_regions);
+    if (!standard_regions) {
+        putWord(state, (uint64_t) regions.getUnitCount());
+        for (int unit = 0; unit < regions.getUnitCount(); ++unit) {
+            putWord(state, (uint64_t) regions.unitSize(unit));
+            for (int x = 0; x < regions.unitSize(unit); ++x) {
+                putWord(state, (uint64_t) regions.unitCells(unit)[x]);
             }
+        }
+    }
+}
+
+/**
+ * Restores a search serialized by saveSearch. Every count and index is checked against
+ * the board size before use.
+ *
+ * @param state (serialized search)
+ * @return false if the data is not a valid search (the board is then reset)
+ */
+bool Sudoku::loadSearch(const std::vector<uint8_t> &state) {
+    StateReader reader(state);
+    int new_side_length = reader.word() == SEARCH_MAGIC ? reader.bounded(64) : 0;
+    int new_box_size = (int) (sqrt(new_side_length));
 
+    if (new_side_length == 0 || new_box_size * new_box_size != new_side_length) {
+        reset();
+        return false;
+    }
 
-            std::cout << std::endl;
+    int cell_count = new_side_length * new_side_length;
+    side_length = new_side_length;
+    box_size = new_box_size;
+    fill_counter = reader.bounded((uint64_t) cell_count);
+    depth = reader.bounded((uint64_t) cell_count);
+    search_status = (SearchStatus) reader.bounded((uint64_t) SearchStatus::IDLE);
+    branch_result = (BranchResult) reader.bounded(BRANCH_FAILED);
+    value_order = (ValueOrder) reader.bounded((uint64_t) ValueOrder::RANDOM);
+    backjumping = reader.bounded(1) != 0;
+    random = SearchRandom(reader.word());
+    stats = SearchStats();
+    stats.nodes = reader.word();
+    stats.backtracks = reader.word();
+    stats.backjumps = reader.word();
+    stats.restarts = reader.word();
+    stats.value_order = value_order;
+
+    SudoBoard.resize(side_length);
+    for (int x = 0; x < side_length; ++x) {
+        SudoBoard[x].resize(side_length);
+        for (int y = 0; y < side_length; ++y) {
+            SudoBoard[x][y] = reader.byte();
+            if (SudoBoard[x][y] > side_length) {
+                reader.fail();
+            }
         }
-    } else {                                     //print format for all other board sizes
-        for (int x = 0; x < side_length; ++x) {
-            for (int y = 0; y < side_length; ++y) {
-                std::cout << SudoBoard[x][y] << " ";
+    }
+
+    conflict_words = cell_count / 64 + 1;
+    cell_levels.assign(cell_count, 0);
+    conflict_sets.assign((cell_count + 1) * conflict_words, 0);
+    conflict.assign(conflict_words, 0);
+    lowest_levels.resize(side_length + 1);
+    if ((int) frames.size() < cell_count + 1) {
+        frames.resize(cell_count + 1);
+    }
+
+    for (int cell = 0; cell < cell_count; ++cell) {
+        cell_levels[cell] = reader.bounded((uint64_t) depth);
+    }
+    for (int x = conflict_words; x < (depth + 1) * conflict_words; ++x) {
+        conflict_sets[x] = reader.word();
+    }
+    for (int x = 0; x < conflict_words; ++x) {
+        conflict[x] = reader.word();
+    }
+
+    for (int level = 1; level <= depth && reader.good(); ++level) {
+        Frame &frame = frames[level - 1];
+        int cell = reader.bounded((uint64_t) cell_count - 1);
+        frame.square = std::pair<int, int>(cell / side_length, cell % side_length);
+        frame.sequential = reader.bounded(1) != 0;
+        frame.next = reader.bounded((uint64_t) side_length + 1);
+        frame.values.resize(reader.bounded((uint64_t) side_length));
+        for (int &val : frame.values) {
+            val = reader.byte();
+            if (val == 0 || val > side_length) {
+                reader.fail();
             }
+        }
+    }
 
-            std::cout << std::endl;
+    standard_regions = false;                        // forces useStandardRegions to rebuild
+    useStandardRegions();
+    if (reader.bounded(1) == 0 && reader.good()) {
+        RegionModel model(side_length);
+        int unit_count = reader.bounded((uint64_t) 4 * cell_count);
+        for (int unit = 0; unit < unit_count && reader.good(); ++unit) {
+            std::vector<int> cells(reader.bounded((uint64_t) side_length));
+            for (int &cell : cells) {
+                cell = reader.bounded((uint64_t) cell_count - 1);
+            }
+            model.addUnit(cells);
         }
+        regions = model;
+        standard_regions = false;
     }
+
+    live_state = false;
+    if (!reader.complete()) {
+        reset();
+        return false;
+    }
+    countPlaced();
+    return true;
 }
 
 /**
- * Solves Sudoku board by getting first open square, then calling place on this
- * open
- * square. Actively modifies the existing board.
+ * Writes saveSearch's data to a file, replacing it only once the new data is complete
  *
- * @return true if solution exists, false if not solution exists
+ * @param filename (checkpoint path)
+ * @return false if the file could not be written
  */
-bool Sudoku::solve() {
-    std::pair<int, int> firstOpenSquare = firstPass();
+bool Sudoku::saveSearch(std::string filename) const {
+    std::vector<uint8_t> state;
+    saveSearch(state);
 
-    return place(firstOpenSquare);
+    std::string temp = filename + ".tmp";
+    FILE *file = fopen(temp.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    bool written = fwrite(state.data(), 1, state.size(), file) == state.size();
+    written &= fclose(file) == 0;
+    if (!written || rename(temp.c_str(), filename.c_str()) != 0) {
+        remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Restores a search from a file written by saveSearch
+ *
+ * @param filename (checkpoint path)
+ * @return false if the file is missing or not a valid search (the board is then reset)
+ */
+bool Sudoku::loadSearch(std::string filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<uint8_t> state((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+    return loadSearch(state);
+}
+
+/**
+ * @return node, backtrack and value-order stats of the last solve
+ */
+const SearchStats &Sudoku::getStats() const {
+    return stats;
+}
+
+/**
+ * Counts the solutions of the current board without modifying it, using a pooled
+ * SolverContext and its memoized counting search. Boards up to 64 x 64 are supported.
+ *
+ * @param limit (stop once this many solutions are found, 0 = count them all)
+ * @return number of solutions, capped at limit (0 for unsupported boards)
+ */
+unsigned long long Sudoku::countSolutions(unsigned long long limit) const {
+    std::vector<uint8_t> cells(side_length * side_length);
+    storeCells(cells.data());
+
+    SolverPool::Lease context = SolverPool::acquire();
+    if (!context->arm(cells.data(), regions)) {
+        return 0;
+    }
+
+    return context->countSolutions(limit);
 }
 
 /**
@@ -127,71 +600,431 @@ bool Sudoku::equals(const Sudoku &other) const {
 }
 
 /**
-* Given a square and value on the board, checks column, row, and appropriate Sudoku block
-* for numbers already in use. Returns false if the value is already in use, true if not.
-*
-* @param square (pair representing the appropriate 'square' on the board), val
- * (integer value to check)
-* @return false if the value val is not a potential value on the square, true if not
-*/
-bool Sudoku::place(std::pair<int, int> thisSquare) {
-    // iterates over all possible numbers for a square, and calls place on the
-    // next open square
-    if (fill_counter < side_length) {   //if not enough squares are full
-        ++fill_counter;
-        for (int x = 1; x <= side_length; x++) {
-            if (!isValuePossible(thisSquare, x)) {
-                continue;
-            }
-            SudoBoard[thisSquare.first][thisSquare.second] = x;
-            std::pair<int, int> nextSquare = openSquare(thisSquare);
+ * Stores a Sudoku board configuration from a flat row-major buffer, reusing the rows
+ * already allocated for the board. A side length that is not a square, or is over 64,
+ * resets the board.
+ *
+ * @param cells (new_side_length * new_side_length values, 0 for empty squares)
+ * @param new_side_length (number of rows and cols on the board)
+ */
+void Sudoku::loadFromCells(const uint8_t *cells, int new_side_length) {
+    int new_box_size = new_side_length > 0 ? (int) (sqrt(new_side_length)) : 0;
+    if (new_box_size * new_box_size != new_side_length || new_side_length > SIDE_MAX) {
+        reset();
+        return;
+    }
 
-            if (place(nextSquare)) {
-                return true;
-            }
+    side_length = new_side_length;
+    box_size = new_box_size;
+    fill_counter = 0;
+
+    SudoBoard.resize(side_length);
+
+    for (int x = 0; x < side_length; ++x) {
+        SudoBoard[x].assign(cells + x * side_length, cells + (x + 1) * side_length);
+    }
+
+    live_state = false;
+    search_status = SearchStatus::IDLE;
+    useStandardRegions();
+}
+
+/**
+ * Copies the board into a flat row-major buffer
+ *
+ * @param cells (buffer of at least side_length * side_length values)
+ */
+void Sudoku::storeCells(uint8_t *cells) const {
+    for (int x = 0; x < side_length; ++x) {
+        for (int y = 0; y < side_length; ++y) {
+            cells[x * side_length + y] = (uint8_t) SudoBoard[x][y];
         }
-    } else {                        //if enough squares are full use smartplace strategy
-        return smartPlace();
+    }
+}
+
+/**
+ * Serializes the board into a caller-owned buffer without allocating
+ *
+ * @param out (buffer of at least formattedSize(side_length, style) bytes)
+ * @param style (layout to write; PRETTY is what print shows)
+ * @return number of bytes written
+ */
+std::size_t Sudoku::format(char *out, GridStyle style) const {
+    uint8_t cells[SIDE_MAX * SIDE_MAX];          //loads refuse boards wider than this
+    storeCells(cells);
+    return formatGrid(cells, side_length, style, out);
+}
+
+/**
+ * Replaces the constraint model of the current board, e.g. with RegionModel::diagonal
+ * for X-sudoku or RegionModel::jigsaw for irregular regions. The next loadFromFile or
+ * loadFromCells goes back to the standard model.
+ *
+ * @param model (model for a board of the current side length)
+ * @return false if the model is for a different board size
+ */
+bool Sudoku::setRegions(const RegionModel &model) {
+    if (model.getSideLength() != side_length) {
+        return false;
+    }
+
+    regions = model;
+    standard_regions = false;
+    live_state = false;
+    search_status = SearchStatus::IDLE;
+    return true;
+}
+
+/**
+ * @return number of rows and cols on the board
+ */
+int Sudoku::getSideLength() const {
+    return side_length;
+}
+
+/**
+ * Places a value on a square of the live board, updating the unit masks behind
+ * isValid, isSolvable and getCandidates in place. Only the units of the square are
+ * touched, so an edit costs the same on any board size.
+ *
+ * @param row (row of the square), col (col of the square)
+ * @param val (value to place, 0 clears the square)
+ * @return false if the square or value is out of range
+ */
+bool Sudoku::setCell(int row, int col, int val) {
+    if (row < 0 || row >= side_length || col < 0 || col >= side_length ||
+        val < 0 || val > side_length) {
+        return false;
+    }
+
+    if (!live_state) {
+        buildLiveState();
+    }
+
+    int cell = row * side_length + col;
+    int old_val = SudoBoard[row][col];
+    if (old_val == val) {
+        return true;
+    }
+
+    if (old_val != 0) {
+        countValue(cell, old_val, -1);
+        known_unsolvable = false;       //removing a value can only open up solutions
+        if (!last_solution.empty() && last_solution[cell] != old_val) {
+            --mismatches;
+        }
+    }
+
+    if (val != 0) {
+        countValue(cell, val, 1);
+        if (!last_solution.empty() && last_solution[cell] != val) {
+            ++mismatches;
+        }
+    }
+
+    SudoBoard[row][col] = val;
+    search_status = SearchStatus::IDLE;
+
+    if (old_val != 0) {
+        //eliminations may have rested on the removed value, so candidates start over
+        refreshCandidates();
+    } else {
+        //a placement only takes its value away from the peers
+        const int *peers = regions.peers(cell);
+        uint64_t bit = ~(1ull << (val - 1));
+
+        cell_candidates[cell] = 0;
+        for (int x = regions.peerCount(cell) - 1; x >= 0; --x) {
+            cell_candidates[peers[x]] &= bit;
+        }
+    }
+    return true;
+}
+
+/**
+ * Clears a square of the live board, same as setCell(row, col, 0)
+ *
+ * @param row (row of the square), col (col of the square)
+ */
+void Sudoku::clearCell(int row, int col) {
+    setCell(row, col, 0);
+}
+
+/**
+ * @return true if no unit of the board holds a value twice (empty squares are fine)
+ */
+bool Sudoku::isValid() {
+    if (!live_state) {
+        buildLiveState();
+    }
+
+    return conflicts == 0;
+}
+
+/**
+ * Checks whether the board can still be completed, searching as long as it takes. An
+ * interactive caller that needs a bound on every query uses checkSolvable instead.
+ *
+ * @return true if at least one solution exists
+ */
+bool Sudoku::isSolvable() {
+    return checkSolvable(0) == SearchStatus::SOLVED;
+}
+
+/**
+ * Checks whether the board can still be completed. Answers from the last solution
+ * found when every filled square still agrees with it, and from the last failure when
+ * values were only added since. Otherwise searches again with propagation on a pooled
+ * context whose buffers stay warm from the previous query. A wrong but legal value can
+ * leave a board whose refutation takes far longer than any solve, so the search may be
+ * capped; a capped search caches nothing. On 16 x 16 boards the default budget keeps
+ * an edit plus its query under a millisecond.
+ *
+ * @param node_budget (nodes the search may take, 0 = no limit)
+ * @return SOLVED, UNSOLVABLE, or SUSPENDED if the budget ran out before an answer
+ */
+SearchStatus Sudoku::checkSolvable(unsigned long long node_budget) {
+    if (!live_state) {
+        buildLiveState();
+    }
+    if (conflicts != 0 || known_unsolvable) {
+        return SearchStatus::UNSOLVABLE;
+    }
+
+    if (!last_solution.empty() && mismatches == 0) {   //last solution still fits
+        return SearchStatus::SOLVED;
+    }
+
+    last_solution.resize(side_length * side_length);
+    storeCells(last_solution.data());
+
+    SearchOptions options;
+    options.propagate = true;
+    options.node_limit = node_budget;
+
+    SolverPool::Lease context = SolverPool::acquire();
+    bool solved = context->arm(last_solution.data(), regions) && context->solve(options);
+    context->storeCells(last_solution.data());
+
+    mismatches = 0;
+    if (!solved) {
+        last_solution.clear();
+        if (context->wasCancelled()) {
+            return SearchStatus::SUSPENDED;
+        }
+        known_unsolvable = true;
+        return SearchStatus::UNSOLVABLE;
+    }
+
+    return SearchStatus::SOLVED;
+}
+
+/**
+ * @param row (row of the square), col (col of the square)
+ * @return bitmask of the values (bit val - 1) no peer of the square holds, 0 for a
+ * square off the board
+ */
+uint64_t Sudoku::getCandidates(int row, int col) {
+    if (row < 0 || row >= side_length || col < 0 || col >= side_length) {
+        return 0;
+    }
+
+    if (!live_state) {
+        buildLiveState();
+    }
+
+    int cell = row * side_length + col;
+    const int *units = regions.cellUnits(cell);
+    uint64_t used = 0;
+
+    for (int x = regions.cellUnitCount(cell) - 1; x >= 0; --x) {
+        used |= unit_used[units[x]];
+    }
+
+    uint64_t full = side_length >= 64 ? ~0ull : (1ull << side_length) - 1;
+    return full & ~used;
+}
+
+/**
+ * Finds the cheapest logical deduction on the live board (see findStep), working from
+ * candidate masks that edits and applied steps keep up to date, so a call costs one scan
+ * of the masks instead of rebuilding them from the board
+ *
+ * @param step (filled with the deduction; its buffers are reused between calls)
+ * @return false if no technique applies or the board holds a conflict
+ */
+bool Sudoku::nextStep(Step &step) {
+    if (!live_state) {
+        buildLiveState();
+    }
+
+    if (conflicts != 0) {
+        step = Step();
+        return false;
+    }
+
+    return findStep(regions, cell_candidates.data(), step);
+}
+
+/**
+ * Applies a step found by nextStep: places its value, or removes its eliminations
+ * from the live candidate masks
+ *
+ * @param step (step found on the current board)
+ */
+void Sudoku::applyStep(const Step &step) {
+    if (!live_state) {
+        buildLiveState();
     }
 
+    if (step.value != 0) {
+        setCell(step.cells[0] / side_length, step.cells[0] % side_length, step.value);
+        return;
+    }
+
+    for (const std::pair<int, uint64_t> &elimination : step.eliminations) {
+        cell_candidates[elimination.first] &= ~elimination.second;
+    }
+}
+
+/**
+ * Opens a branch on the given open square while fewer than side_length squares are
+ * filled; its values are tried in order, each followed by the next open square. Once
+ * enough squares are full the smartPlace strategy takes over.
+ *
+ * @param thisSquare (open square on the board)
+ * @return how the branch opened
+ */
+Sudoku::BranchResult Sudoku::place(std::pair<int, int> thisSquare) {
+    if (fill_counter >= side_length) {  //if enough squares are full use smartplace strategy
+        return smartPlace();
+    }
 
-    SudoBoard[thisSquare.first][thisSquare.second] = 0; // if no solutions are found, reset
-    --fill_counter;
-    return false;
+    pushFrame(thisSquare, true);
+    return BRANCH_OPENED;
 }
 
 /**
  * Useful, more intelligent place method that checks the board for squares with minimum
- * numbers of possibilities before proceeding to place and iterate through possibilites
- * through recursive backtracking.
+ * numbers of possibilities and opens a branch on one of them, its possibilities ordered
+ * by value_order.
  *
- * @return true if a solution is found on the board, false if not
+ * @return how the branch opened: BRANCH_SOLVED on a full board, BRANCH_FAILED (with
+ * conflict set) if some square has no possibilities left
  */
-bool Sudoku::smartPlace() {
-    std::vector<int> allpossibles;
+Sudoku::BranchResult Sudoku::smartPlace() {
+    std::vector<int> &allpossibles = frames[depth].values;
     std::pair<int, int> thisSquare = leastAmbiguousSquare(allpossibles);
 
-    if (fill_counter == side_length * side_length) {  //if board is full return true
-        return true;
+    if (fill_counter == side_length * side_length) {  //if board is full
+        return BRANCH_SOLVED;
     }
 
     if (thisSquare.first == -1) {    //if there is an impossible square to satisfy
-        return false;
+        std::fill(conflict.begin(), conflict.end(), 0);
+        addBlockers(squares[dead_cell], conflict.data());   //blames whoever emptied it
+        return BRANCH_FAILED;
     }
 
-    // iterates over all possible numbers for a square, and calls place on the
-    // next open square
+    orderValues(thisSquare, allpossibles);
+    pushFrame(thisSquare, false);
+    return BRANCH_OPENED;
+}
+
+/**
+ * Pushes the frame of a new decision level on the square
+ *
+ * @param square (square the branch fills)
+ * @param sequential (true for a place branch, false for a smartPlace branch whose
+ * values were already stored in the new frame)
+ */
+void Sudoku::pushFrame(std::pair<int, int> square, bool sequential) {
     ++fill_counter;
-    for (int x = 0; x < allpossibles.size(); x++) {
-        SudoBoard[thisSquare.first][thisSquare.second] = allpossibles[x];
-        if (smartPlace()) {
-            return true;
+    int level = ++depth;
+    uint64_t *conflict_set = &conflict_sets[level * conflict_words];
+    std::fill(conflict_set, conflict_set + conflict_words, 0);
+    cell_levels[square.first * side_length + square.second] = level;
+
+    Frame &frame = frames[level - 1];
+    frame.square = square;
+    frame.sequential = sequential;
+    frame.next = sequential ? 1 : 0;
+}
+
+/**
+ * @return next value the frame should try, 0 once it has none left
+ */
+int Sudoku::nextValue(Frame &frame) {
+    if (!frame.sequential) {
+        return frame.next < (int) frame.values.size() ? frame.values[frame.next++] : 0;
+    }
+
+    while (frame.next <= side_length) {
+        int val = frame.next++;
+        if (isValuePossible(frame.square, val)) {
+            return val;
         }
     }
+    return 0;
+}
+
+/**
+ * Adds to a set of decision levels, for every value a peer of the square already holds,
+ * the lowest level that placed it. Values held by a given add nothing, since no amount
+ * of backtracking frees them. Taking the lowest level lets the search jump as far back
+ * as the board allows.
+ *
+ * @param square (square whose taken values are explained)
+ * @param levels (set of decision levels, conflict_words words)
+ */
+void Sudoku::addBlockers(std::pair<int, int> square, uint64_t *levels) {
+    int cell = square.first * side_length + square.second;
+    const int *peers = regions.peers(cell);
+
+    std::fill(lowest_levels.begin(), lowest_levels.end(), -1);
+
+    for (int x = regions.peerCount(cell) - 1; x >= 0; --x) {
+        const std::pair<int, int> &peer = squares[peers[x]];
+        int val = SudoBoard[peer.first][peer.second];
+        if (val == 0 || val > side_length) {
+            continue;
+        }
+
+        int level = cell_levels[peers[x]];
+        if (lowest_levels[val] == -1 || level < lowest_levels[val]) {
+            lowest_levels[val] = level;
+        }
+    }
+
+    for (int val = 1; val <= side_length; ++val) {
+        int level = lowest_levels[val];
+        if (level > 0) {
+            levels[level >> 6] |= 1ull << (level & 63);
+        }
+    }
+}
 
-    SudoBoard[thisSquare.first][thisSquare.second] = 0; // reset if no solutions are found
-    --fill_counter;                                     // decrements board fill count
-    return false;
+/**
+ * Helper for continueSearch after a branch at the given level failed. Merges the
+ * branch's conflict into the level's set, or reports that the conflict does not
+ * involve the level at all.
+ *
+ * @param level (decision level of the failed branch)
+ * @return false if the level is not in conflict, i.e. the search should jump past it
+ */
+bool Sudoku::mergeConflict(int level) {
+    if (!(conflict[level >> 6] & (1ull << (level & 63)))) {
+        return false;
+    }
+
+    uint64_t *conflict_set = &conflict_sets[level * conflict_words];
+    conflict[level >> 6] &= ~(1ull << (level & 63));
+
+    for (int x = 0; x < conflict_words; ++x) {
+        conflict_set[x] |= conflict[x];
+    }
+
+    return true;
 }
 
 /**
@@ -204,26 +1037,17 @@ bool Sudoku::smartPlace() {
  * @return std::vector of potential numbers that could be on the 'square'
  */
 bool Sudoku::isValuePossible(std::pair<int, int> square, int val) const {
-
-    // checks potential value against local column square values and row square values
-    // that are already in use
-    for (int x = 0; x < side_length; ++x) {
-        if (SudoBoard[square.first][x] == val || SudoBoard[x][square.second] == val)
+    int cell = square.first * side_length + square.second;
+    const int *peers = regions.peers(cell);
+
+    // checks potential value against every square sharing a unit (row, column, box or
+    // any variant region) with this square
+    for (int x = regions.peerCount(cell) - 1; x >= 0; --x) {
+        const std::pair<int, int> &peer = squares[peers[x]];
+        if (SudoBoard[peer.first][peer.second] == val)
             return false;
     }
 
-    // decides if val is valid by checking local Sudoku 3 x 3 "square" for values
-    // already in use
-    int left_upper_row = box_size * (square.first / box_size);
-    int left_upper_col = box_size * (square.second / box_size);
-
-    for (int a = 0; a < box_size; ++a) {
-        for (int b = 0; b < box_size; ++b) {
-            if (SudoBoard[left_upper_row + a][left_upper_col + b] == val)
-                return false;
-        }
-    }
-
     return true;
 }
 
@@ -236,31 +1060,100 @@ bool Sudoku::isValuePossible(std::pair<int, int> square, int val) const {
  * @param tmp (tmp is filled with all possible values)
  */
 void Sudoku::getAllPotentialValues(std::pair<int, int> square, std::vector<int> &tmp) {
+    int cell = square.first * side_length + square.second;
+    const int *peers = regions.peers(cell);
+    uint64_t used = 0;
+
+    // marks values already in use on every square sharing a unit with this square
+    for (int x = regions.peerCount(cell) - 1; x >= 0; --x) {
+        const std::pair<int, int> &peer = squares[peers[x]];
+        int val = SudoBoard[peer.first][peer.second];
+        // bit val - 1, so 64 x 64 boards fit; values past the side block nothing
+        used |= val > 0 && val <= side_length ? 1ull << (val - 1) : 0;
+    }
+
     tmp.clear();
 
     for (int x = 1; x <= side_length; ++x) {
-        tmp.push_back(x);
+        if (!(used & (1ull << (x - 1)))) {
+            tmp.push_back(x);
+        }
     }
-    // eliminates possible values from potentialValues by checking local column
-    // and row squares for values already in use
-    for (int x = 0; x < side_length; ++x) {
-        tmp.erase(std::remove(tmp.begin(), tmp.end(), SudoBoard[square.first][x]),
-                  tmp.end());
-        tmp.erase(std::remove(tmp.begin(), tmp.end(), SudoBoard[x][square.second]),
-                  tmp.end());
+}
+
+/**
+ * Helper method for smartPlace. Reorders the potential values of a square according
+ * to value_order:
+ *  - LEAST_CONSTRAINING puts first the values that the fewest empty peers could still
+ *    take, so placing them eliminates the least
+ *  - FREQUENCY puts first the values already placed most often on the board
+ *  - RANDOM shuffles the values with the seeded generator
+ *
+ * @param square (square the values belong to)
+ * @param values (potential values of the square, reordered in place)
+ */
+void Sudoku::orderValues(std::pair<int, int> square, std::vector<int> &values) {
+    if (value_order == ValueOrder::ASCENDING || values.size() < 2) {
+        return;
     }
 
+    if (value_order == ValueOrder::RANDOM) {
+        for (int x = (int) values.size() - 1; x > 0; --x) {   // Fisher-Yates shuffle
+            std::swap(values[x], values[random.below((uint32_t) x + 1)]);
+        }
+        return;
+    }
 
-    // eliminates possible values from potentialValues by checking local Sudoku
-    // 3 x 3 "square" for values already in use
-    int left_upper_row = box_size * (square.first / box_size);
-    int left_upper_col = box_size * (square.second / box_size);
+    value_scores.clear();                      // (score, value), lower score goes first
+    int cell = square.first * side_length + square.second;
+    const int *peers = regions.peers(cell);
 
-    for (int a = 0; a < box_size; ++a) {
-        for (int b = 0; b < box_size; ++b) {
-            tmp.erase(std::remove(tmp.begin(), tmp.end(),
-                                  SudoBoard[left_upper_row + a][left_upper_col + b]),
-                      tmp.end());
+    for (int val : values) {
+        int score = 0;
+
+        if (value_order == ValueOrder::LEAST_CONSTRAINING) {
+            // counts empty peers that would lose val as a candidate
+            for (int x = regions.peerCount(cell) - 1; x >= 0; --x) {
+                const std::pair<int, int> &peer = squares[peers[x]];
+
+                if (SudoBoard[peer.first][peer.second] == 0 && isValuePossible(peer, val)) {
+                    ++score;
+                }
+            }
+        } else {
+            // placements of val, negated so the most frequent sorts first
+            score = -placed_count[val];
+        }
+
+        value_scores.push_back(std::pair<int, int>(score, val));
+    }
+
+    std::stable_sort(value_scores.begin(), value_scores.end());
+
+    for (int x = 0; x < (int) values.size(); ++x) {
+        values[x] = value_scores[x].second;
+    }
+}
+
+/**
+ * Writes a value (0 to empty) on a square during a search, keeping placed_count
+ * in step with the board
+ */
+void Sudoku::setSquare(std::pair<int, int> square, int val) {
+    int &current = SudoBoard[square.first][square.second];
+    --placed_count[current];
+    ++placed_count[val];
+    current = val;
+}
+
+/**
+ * Recounts placed_count from the board when a search starts or is restored
+ */
+void Sudoku::countPlaced() {
+    placed_count.assign(side_length + 1, 0);
+    for (const std::vector<int> &row : SudoBoard) {
+        for (int val : row) {
+            ++placed_count[val >= 0 && val <= side_length ? val : 0];
         }
     }
 }
@@ -326,6 +1219,7 @@ std::pair<int, int> Sudoku::leastAmbiguousSquare(std::vector<int> &myvec) {
             int curr_value = tmp.size();
 
             if (curr_value == 0) {  //if an impossible square is found, return (-1,-1)
+                dead_cell = x;
                 return {-1, -1};
             }
 
@@ -388,20 +1282,106 @@ std::pair<int, int> Sudoku::firstPass() {
  */
 void Sudoku::reset() {
 
-    SudoBoard.clear();
     side_length = 9;
     box_size = 3;
     fill_counter = 0;
 
+    SudoBoard.resize(9);                // keeps existing rows and their storage
+
     for (int x = 0; x < 9; x++) {
-        std::vector<int> tmp;           // stores each row in tmp
+        SudoBoard[x].assign(9, 0);      //fills row with zeroes
+    }
+
+    live_state = false;
+    search_status = SearchStatus::IDLE;
 
-        for (int y = 0; y < 9; y++) {
-            tmp.push_back(0);           //fills row with zeroes
+    useStandardRegions();
+}
+
+/**
+ * Rebuilds the unit counts and masks of the live state from SudoBoard and forgets
+ * the last solution
+ */
+void Sudoku::buildLiveState() {
+    value_counts.assign(regions.getUnitCount() * side_length, 0);
+    unit_used.assign(regions.getUnitCount(), 0);
+    conflicts = 0;
+
+    for (int x = 0; x < side_length * side_length; ++x) {
+        int val = SudoBoard[x / side_length][x % side_length];
+        if (val != 0) {
+            countValue(x, val, 1);
         }
+    }
 
-        SudoBoard.push_back(tmp);       //puts tmp in board
-        tmp.clear();
+    last_solution.clear();
+    mismatches = 0;
+    known_unsolvable = false;
+    live_state = true;
+
+    refreshCandidates();
+}
+
+/**
+ * Recomputes cell_candidates from the unit masks, dropping applied eliminations
+ */
+void Sudoku::refreshCandidates() {
+    cell_candidates.resize(side_length * side_length);
+
+    for (int x = 0; x < side_length * side_length; ++x) {
+        cell_candidates[x] = SudoBoard[x / side_length][x % side_length] == 0 ?
+                             getCandidates(x / side_length, x % side_length) : 0;
+    }
+}
+
+/**
+ * Adds (change = 1) or removes (change = -1) a value of a square in the unit counts.
+ * A value outside 1..side_length counts as a conflict on its own.
+ */
+void Sudoku::countValue(int cell, int val, int change) {
+    if (val < 1 || val > side_length) {
+        conflicts += change;
+        return;
+    }
+
+    const int *units = regions.cellUnits(cell);
+    uint64_t bit = 1ull << (val - 1);
+
+    for (int x = regions.cellUnitCount(cell) - 1; x >= 0; --x) {
+        uint8_t &count = value_counts[units[x] * side_length + val - 1];
+
+        if (change > 0) {
+            if (++count == 2) {          //value is now repeated in this unit
+                ++conflicts;
+            }
+            unit_used[units[x]] |= bit;
+        } else {
+            if (count-- == 2) {
+                --conflicts;
+            }
+            if (count == 0) {
+                unit_used[units[x]] &= ~bit;
+            }
+        }
+    }
+}
+
+/**
+ * Switches the constraint model back to rows, columns and boxes, only rebuilding the
+ * tables when the board size changed or a variant model was in use
+ */
+void Sudoku::useStandardRegions() {
+    if (!standard_regions || regions.getSideLength() != side_length) {
+        regions = RegionModel::standard(side_length);
+        standard_regions = true;
+    }
+
+    if ((int) squares.size() != side_length * side_length) {
+        squares.resize(side_length * side_length);
+
+        for (int x = 0; x < side_length * side_length; ++x) {
+            squares[x] = std::pair<int, int>(x / side_length, x % side_length);
+        }
     }
 }
 
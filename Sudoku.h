@@ -6,8 +6,13 @@
 #ifndef SUDOKU_H
 #define SUDOKU_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include "GridFormat.h"
+#include "Logic.h"
+#include "RegionModel.h"
+#include "SearchOptions.h"
 
 /**
  * class that reads in Sudoku board from an appropriately formatted textfile and then
@@ -22,7 +27,8 @@ public:
     Sudoku();
 
     /**
-    *Stores a Sudoku board configuration from the given textfile name / path
+    *Stores a Sudoku board configuration from the given textfile name / path. A board
+    *whose side length is not a square, or is over 64, resets the board.
     *
     *@param filename (textfile path/name containing Sudokuboard start in
     *appropriate
@@ -44,6 +50,96 @@ public:
     */
     bool solve();
 
+    /**
+    * Solves the board with SatSudoku's clause-learning search, often far faster than
+    * solve() on boards of 25 x 25 and up. Runs to the end in one call, with no node
+    * stats and no way to suspend; saveSearch afterwards records a finished search.
+    *
+    * @return true if solution exists, false if no solution exists or the board is wider
+    * than 64
+    */
+    bool solveSat();
+
+    /**
+    * Solves the Sudoku board like solve(), trying the candidates of each square picked by
+    * smartPlace in the given order. The order used is reported in getStats().
+    *
+    * @param order (value-ordering policy for this call)
+    * @param seed (seed for ValueOrder::RANDOM, ignored otherwise)
+    * @return true if solution exists, false if not solution exists
+    */
+    bool solve(ValueOrder order, uint64_t seed = 0);
+
+    /**
+    * Starts a resumable solve of the current board; nothing is placed until
+    * continueSearch runs. solve(order, seed) is beginSearch then continueSearch(0).
+    *
+    * @param order (value-ordering policy for the search)
+    * @param seed (seed for ValueOrder::RANDOM, ignored otherwise)
+    * @param backjump (false to back up one level after every failure, as plain
+    * chronological backtracking does)
+    */
+    void beginSearch(ValueOrder order = ValueOrder::ASCENDING, uint64_t seed = 0,
+                     bool backjump = true);
+
+    /**
+    * Runs the search started by beginSearch (or restored by loadSearch) until it ends or
+    * places node_budget more values. A suspended search leaves its partial board in
+    * place; editing or reloading the board abandons it.
+    *
+    * @param node_budget (values to place before suspending, 0 = no limit)
+    * @return SOLVED, UNSOLVABLE, or SUSPENDED if the budget ran out first
+    */
+    SearchStatus continueSearch(unsigned long long node_budget = 0);
+
+    /**
+    * Serializes the search at its current node boundary: board, constraint model,
+    * decision stack with the values each branch has left, conflict sets, random state
+    * and stats. Restoring it with loadSearch, in this or another process, continues
+    * exactly the same search.
+    *
+    * @param state (replaced with the serialized search)
+    */
+    void saveSearch(std::vector<uint8_t> &state) const;
+
+    /**
+    * Restores a search serialized by saveSearch
+    *
+    * @param state (serialized search)
+    * @return false if the data is not a valid search (the board is then reset)
+    */
+    bool loadSearch(const std::vector<uint8_t> &state);
+
+    /**
+    * Writes saveSearch's data to a file, replacing it only once the new data is complete
+    *
+    * @param filename (checkpoint path)
+    * @return false if the file could not be written
+    */
+    bool saveSearch(std::string filename) const;
+
+    /**
+    * Restores a search from a file written by saveSearch
+    *
+    * @param filename (checkpoint path)
+    * @return false if the file is missing or not a valid search (the board is then reset)
+    */
+    bool loadSearch(std::string filename);
+
+    /**
+    * @return node, backtrack and value-order stats of the last solve
+    */
+    const SearchStats &getStats() const;
+
+    /**
+    * Counts the solutions of the current board without modifying it. Boards up to
+    * 64 x 64 are supported.
+    *
+    * @param limit (stop once this many solutions are found, 0 = count them all)
+    * @return number of solutions, capped at limit (0 for unsupported boards)
+    */
+    unsigned long long countSolutions(unsigned long long limit = 0) const;
+
     /**
     * Checks whether every square on the other Sudoku object's board is equal to
     * the
@@ -54,6 +150,112 @@ public:
     */
     bool equals(const Sudoku &other) const;
 
+    /**
+    * Stores a Sudoku board configuration from a flat row-major buffer, reusing the rows
+    * already allocated for the board. A side length that is not a square, or is over
+    * 64, resets the board.
+    *
+    * @param cells (new_side_length * new_side_length values, 0 for empty squares)
+    * @param new_side_length (number of rows and cols on the board)
+    */
+    void loadFromCells(const uint8_t *cells, int new_side_length);
+
+    /**
+    * Copies the board into a flat row-major buffer
+    *
+    * @param cells (buffer of at least side_length * side_length values)
+    */
+    void storeCells(uint8_t *cells) const;
+
+    /**
+    * Serializes the board into a caller-owned buffer without allocating
+    *
+    * @param out (buffer of at least formattedSize(side_length, style) bytes)
+    * @param style (layout to write; PRETTY is what print shows)
+    * @return number of bytes written
+    */
+    std::size_t format(char *out, GridStyle style) const;
+
+    /**
+    * Replaces the constraint model of the current board, e.g. with RegionModel::diagonal
+    * for X-sudoku or RegionModel::jigsaw for irregular regions. The next loadFromFile or
+    * loadFromCells goes back to the standard model.
+    *
+    * @param model (model for a board of the current side length)
+    * @return false if the model is for a different board size
+    */
+    bool setRegions(const RegionModel &model);
+
+    /**
+    * @return number of rows and cols on the board
+    */
+    int getSideLength() const;
+
+    /**
+    * Places a value on a square of the live board, updating the unit masks behind
+    * isValid, isSolvable and getCandidates in place
+    *
+    * @param row (row of the square), col (col of the square)
+    * @param val (value to place, 0 clears the square)
+    * @return false if the square or value is out of range
+    */
+    bool setCell(int row, int col, int val);
+
+    /**
+    * Clears a square of the live board, same as setCell(row, col, 0)
+    *
+    * @param row (row of the square), col (col of the square)
+    */
+    void clearCell(int row, int col);
+
+    /**
+    * @return true if no unit of the board holds a value twice (empty squares are fine)
+    */
+    bool isValid();
+
+    /**
+    * Checks whether the board can still be completed, searching as long as it takes
+    * (checkSolvable with no node budget)
+    *
+    * @return true if at least one solution exists
+    */
+    bool isSolvable();
+
+    /**
+    * Checks whether the board can still be completed. Answers from the last solution
+    * found when every filled square still agrees with it, and only searches again
+    * (with a warm pooled context) when an edit broke that solution. The node budget
+    * bounds every query, for use once per keystroke.
+    *
+    * @param node_budget (nodes the search may take, 0 = no limit)
+    * @return SOLVED, UNSOLVABLE, or SUSPENDED if the budget ran out before an answer
+    */
+    SearchStatus checkSolvable(unsigned long long node_budget = 16);
+
+    /**
+    * @param row (row of the square), col (col of the square)
+    * @return bitmask of the values (bit val - 1) no peer of the square holds, 0 for a
+    * square off the board
+    */
+    uint64_t getCandidates(int row, int col);
+
+    /**
+    * Finds the cheapest logical deduction on the live board (see findStep), working
+    * from candidate masks that edits and applied steps keep up to date
+    *
+    * @param step (filled with the deduction; its buffers are reused between calls)
+    * @return false if no technique applies or the board holds a conflict
+    */
+    bool nextStep(Step &step);
+
+    /**
+    * Applies a step found by nextStep: places its value, or removes its eliminations
+    * from the live candidate masks
+    *
+    * @param step (step found on the current board)
+    */
+    void applyStep(const Step &step);
+
 private:
 
     std::vector<std::vector<int>> SudoBoard; // stores Sudoku Board
@@ -63,32 +265,118 @@ private:
     int box_size;    //side length of each Sudoku inner box (square root of side_length)
     int fill_counter; //number of non-empty spaces on the board
 
+    RegionModel regions;   //units and per-square peer lists the board is checked against
+    bool standard_regions; //true if regions holds the plain row/col/box model
+    std::vector<std::pair<int, int>> squares; //(row, col) of each cell index in regions
+
+    ValueOrder value_order; //order smartPlace tries candidate values in
+    SearchRandom random;    //source of shuffles for ValueOrder::RANDOM
+    SearchStats stats;      //counters of the last solve
+
+    // conflict-directed backjumping: every placement made by place / smartPlace gets a
+    // decision level, and a failed branch reports the set of levels that caused it
+    bool backjumping;                    //false: every failure backs up one level
+    int depth;                           //decision level of the innermost placement
+    int dead_cell;                       //square with no candidates left, from leastAmbiguousSquare
+    int conflict_words;                  //64-bit words in one set of decision levels
+    std::vector<int> cell_levels;        //decision level of each filled square, 0 for givens
+    std::vector<uint64_t> conflict_sets; //levels blamed so far at each level, one row per level
+    std::vector<uint64_t> conflict;      //levels blamed for the last failed place / smartPlace
+    std::vector<int> lowest_levels;      //scratch for addBlockers, one entry per value
+    std::vector<int> placed_count;       //squares holding each value during a search
+    std::vector<std::pair<int, int>> value_scores; //scratch for orderValues: (score, value)
+
+    /**
+    * Outcome of opening a branch of the search
+    */
+    enum BranchResult {
+        BRANCH_OPENED,    // a frame was pushed; its values are tried by continueSearch
+        BRANCH_SOLVED,    // the board is full
+        BRANCH_FAILED     // no value can go here; conflict holds the levels to blame
+    };
+
     /**
-    * Recursive function that attempts to evaluate the Sudoku board. Recursively
-    * backtracks and attempts all possibilities. A 'true' value propagates up the
-    * recursive stack when there are no open squares left, a false propagates up
-    * the stack
-    * when there all possibilities have been exhausted and there are no solutions.
+    * One open branch of the search: the square it fills and where it is in its values.
+    * The frame of decision level l sits at frames[l - 1].
+    */
+    struct Frame {
+        std::pair<int, int> square;   // square this branch fills
+        bool sequential;              // opened by place: values 1..side_length in order
+        int next;                     // next value (sequential) or index into values
+        std::vector<int> values;      // candidates in the order smartPlace tries them
+    };
+
+    // explicit search state, so a search can stop at any node and be saved or resumed
+    std::vector<Frame> frames;           //decision stack, depth frames in use
+    BranchResult branch_result;          //outcome of the branch opened last
+    SearchStatus search_status;          //SUSPENDED while a search can continue
+
+    // live state for setCell / clearCell, rebuilt lazily after any bulk change
+    bool live_state;                     //false until the masks below match SudoBoard
+    int conflicts;                       //repeated (unit, value) pairs and bad values
+    std::vector<uint8_t> value_counts;   //times each value appears in each unit
+    std::vector<uint64_t> unit_used;     //values present in each unit
+    std::vector<uint8_t> last_solution;  //solution found by isSolvable, empty if none
+    int mismatches;                      //filled squares disagreeing with last_solution
+    bool known_unsolvable;               //isSolvable failed and only values were added since
+    std::vector<uint64_t> cell_candidates; //candidates of each empty square minus applied
+                                           //eliminations, 0 for filled squares
+
+    /**
+    * Opens a branch on the given open square, trying values in order, while fewer than
+    * side_length squares are filled; after that defers to smartPlace.
     *
     * @param thisSquare (open square on the board)
-    * @return true if board is filled successfully, or if place(nextSquare) is
-    * true. False
-    * if no possibilities are found.
+    * @return how the branch opened
+    */
+    BranchResult place(std::pair<int, int> thisSquare);
+
+    /**
+     * Useful, more intelligent place method that opens a branch on the square with the
+    * minimum number of possibilities, to be iterated through by continueSearch.
+    *
+    * @return how the branch opened: BRANCH_SOLVED on a full board, BRANCH_FAILED (with
+    * conflict set) if some square has no possibilities left
     */
-    bool place(std::pair<int, int> thisSquare);
+    BranchResult smartPlace();
 
     /**
-     * Useful, more intelligent place method that checks the board for squares with minimum
-    * numbers of possibilities before proceeding to place and iterate through possibilites
-    * through recursive backtracking.
+    * Pushes the frame of a new decision level on the square
     *
-    * @return true if a solution is found on the board, false if not
+    * @param square (square the branch fills)
+    * @param sequential (true for a place branch, false for a smartPlace branch whose
+    * values were already stored in the new frame)
     */
-    bool smartPlace();
+    void pushFrame(std::pair<int, int> square, bool sequential);
 
     /**
-   * Given a square and value on the board, checks column, row, and appropriate Sudoku block
-   * for numbers already in use. Returns false if the value is already in use, true if not.
+    * @return next value the frame should try, 0 once it has none left
+    */
+    int nextValue(Frame &frame);
+
+    /**
+    * Adds to a set of decision levels, for every value a peer of the square already holds,
+    * the lowest level that placed it. Values held by a given add nothing.
+    *
+    * @param square (square whose taken values are explained)
+    * @param levels (set of decision levels, conflict_words words)
+    */
+    void addBlockers(std::pair<int, int> square, uint64_t *levels);
+
+    /**
+    * Helper for continueSearch after a branch at the given level failed. Merges the
+    * branch's conflict into the level's set, or reports that the conflict does not
+    * involve the level at all.
+    *
+    * @param level (decision level of the failed branch)
+    * @return false if the level is not in conflict, i.e. the search should jump past it
+    */
+    bool mergeConflict(int level);
+
+    /**
+   * Given a square and value on the board, checks every peer of the square (squares that
+   * share a row, column, box or variant region with it) for the value. Returns false if
+   * the value is already in use, true if not.
    *
    * @param square (pair representing the appropriate 'square' on the board), val (value
      * to check)
@@ -105,6 +393,26 @@ private:
     */
     void getAllPotentialValues(std::pair<int, int> square, std::vector<int> &);
 
+    /**
+    * Helper method for smartPlace. Reorders the potential values of a square according
+    * to value_order.
+    *
+    * @param square (square the values belong to)
+    * @param values (potential values of the square, reordered in place)
+    */
+    void orderValues(std::pair<int, int> square, std::vector<int> &values);
+
+    /**
+    * Writes a value (0 to empty) on a square during a search, keeping placed_count
+    * in step with the board
+    */
+    void setSquare(std::pair<int, int> square, int val);
+
+    /**
+    * Recounts placed_count from the board when a search starts or is restored
+    */
+    void countPlaced();
+
     /**
     * Finds the next open square on the board given the current 'square' on the
     * board.
@@ -141,6 +449,28 @@ private:
     * resets the board to 9 x 9 board filled with zeroes
     */
     void reset();
+
+    /**
+    * Switches the constraint model back to rows, columns and boxes, only rebuilding the
+    * tables when the board size changed or a variant model was in use
+    */
+    void useStandardRegions();
+
+    /**
+    * Rebuilds the unit counts and masks of the live state from SudoBoard and forgets
+    * the last solution
+    */
+    void buildLiveState();
+
+    /**
+    * Recomputes cell_candidates from the unit masks, dropping applied eliminations
+    */
+    void refreshCandidates();
+
+    /**
+    * Adds (change = 1) or removes (change = -1) a value of a square in the unit counts
+    */
+    void countValue(int cell, int val, int change);
 };
 
 #endif // ends SUDOKU_H
\ No newline at end of file
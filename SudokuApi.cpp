@@ -0,0 +1,223 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "SudokuApi.h"
+#include "LockstepBatch.h"
+#include "SolverContext.h"
+#include "Validator.h"
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::size_t BATCH_CHUNK = 64;    // puzzles a batch worker claims at a time
+
+/**
+ * @return true if puzzles of this side length can be solved
+ */
+bool solvableSide(int side_length) {
+    int box_size = 1;
+    while (box_size * box_size < side_length) {
+        ++box_size;
+    }
+    return side_length > 0 && side_length <= 64 && box_size * box_size == side_length;
+}
+
+/**
+ * Solves boards [first, last) of a batch on one context, or in lockstep if they are
+ * 9 x 9
+ *
+ * @return number of boards solved
+ */
+std::size_t solveRange(SolverContext &context, LockstepBatch &lockstep,
+                       const uint8_t *puzzles, uint8_t *solutions, int *results,
+                       std::size_t first, std::size_t last, int side_length) {
+    std::size_t cells = (std::size_t) side_length * side_length;
+    std::size_t solved = 0;
+
+    if (side_length == LockstepBatch::SIDE) {
+        bool found[BATCH_CHUNK];
+        solved = lockstep.solve(context, puzzles + first * cells, solutions + first * cells,
+                                last - first, found);
+        for (std::size_t i = first; results && i < last; ++i) {
+            results[i] = found[i - first] ? SUDOKU_OK : SUDOKU_NO_SOLUTION;
+        }
+        return solved;
+    }
+
+    for (std::size_t i = first; i < last; ++i) {
+        const uint8_t *puzzle = puzzles + i * cells;
+        uint8_t *solution = solutions + i * cells;
+        bool found = context.arm(puzzle, side_length) &&
+                     context.solve(SearchOptions::forSide(side_length));
+
+        if (found) {
+            context.storeCells(solution);
+            ++solved;
+        } else if (solution != puzzle) {
+            std::memcpy(solution, puzzle, cells);
+        }
+        if (results) {
+            results[i] = found ? SUDOKU_OK : SUDOKU_NO_SOLUTION;
+        }
+    }
+    return solved;
+}
+
+} // namespace
+
+/**
+ * @return version of the library as "major.minor"
+ */
+const char *sudoku_version(void) {
+    return "1.0";
+}
+
+/**
+ * Solves one puzzle on the calling thread's pooled context
+ *
+ * @return SUDOKU_OK, SUDOKU_NO_SOLUTION or a negative error
+ */
+int sudoku_solve(const uint8_t *puzzle, int side_length, uint8_t *solution) {
+    if (!puzzle || !solution || !solvableSide(side_length)) {
+        return SUDOKU_INVALID_ARGUMENT;
+    }
+
+    try {
+        SolverPool::Lease context = SolverPool::acquire();
+        if (!context->arm(puzzle, side_length) ||
+            !context->solve(SearchOptions::forSide(side_length))) {
+            return SUDOKU_NO_SOLUTION;
+        }
+        context->storeCells(solution);
+        return SUDOKU_OK;
+    } catch (const std::bad_alloc &) {
+        return SUDOKU_INTERNAL_ERROR;
+    }
+}
+
+/**
+ * Counts the solutions of one puzzle on the calling thread's pooled context
+ *
+ * @return SUDOKU_OK, SUDOKU_NO_SOLUTION if the givens conflict, or a negative error
+ */
+int sudoku_count(const uint8_t *puzzle, int side_length, unsigned long long limit,
+                 unsigned long long *count) {
+    if (!puzzle || !count || !solvableSide(side_length)) {
+        return SUDOKU_INVALID_ARGUMENT;
+    }
+
+    try {
+        SolverPool::Lease context = SolverPool::acquire();
+        *count = 0;
+        if (!context->arm(puzzle, side_length)) {
+            return SUDOKU_NO_SOLUTION;
+        }
+        *count = context->countSolutions(limit);
+        return SUDOKU_OK;
+    } catch (const std::bad_alloc &) {
+        return SUDOKU_INTERNAL_ERROR;
+    }
+}
+
+/**
+ * Checks a full or partial grid
+ *
+ * @return a sudoku_grid_status, or SUDOKU_INVALID_ARGUMENT
+ */
+int sudoku_validate(const uint8_t *grid, int side_length) {
+    if (!grid || side_length <= 0 || side_length > 64) {
+        return SUDOKU_INVALID_ARGUMENT;
+    }
+
+    try {
+        return (int) validateGrid(grid, side_length);
+    } catch (const std::bad_alloc &) {
+        return SUDOKU_INTERNAL_ERROR;
+    }
+}
+
+/**
+ * Solves a batch of same-size puzzles. The calling thread and thread_count - 1 helpers
+ * claim chunks of BATCH_CHUNK boards from a shared counter, so a small batch, or one
+ * whose helpers cannot be started, is simply solved by the caller.
+ *
+ * @return number of boards solved, or a negative error
+ */
+long long sudoku_solve_batch(const uint8_t *puzzles, uint8_t *solutions, int *results,
+                             size_t count, int side_length, int thread_count) {
+    if ((count > 0 && (!puzzles || !solutions)) || !solvableSide(side_length)) {
+        return SUDOKU_INVALID_ARGUMENT;
+    }
+
+    if (thread_count <= 0) {
+        thread_count = (int) std::thread::hardware_concurrency();
+        thread_count = thread_count > 0 ? thread_count : 1;
+    }
+    std::size_t chunks = (count + BATCH_CHUNK - 1) / BATCH_CHUNK;
+    if ((std::size_t) thread_count > chunks) {
+        thread_count = chunks > 0 ? (int) chunks : 1;
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> solved(0);
+    std::atomic<bool> failed(false);
+    auto work = [&]() {
+        try {
+            SolverPool::Lease context = SolverPool::acquire();
+            LockstepBatch &lockstep = SolverPool::lockstep();
+            for (std::size_t chunk = next++; chunk < chunks && !failed; chunk = next++) {
+                std::size_t first = chunk * BATCH_CHUNK;
+                std::size_t last = first + BATCH_CHUNK < count ? first + BATCH_CHUNK : count;
+                solved += solveRange(*context, lockstep, puzzles, solutions, results, first,
+                                     last, side_length);
+            }
+        } catch (const std::bad_alloc &) {
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    try {
+        for (int x = 1; x < thread_count; ++x) {
+            helpers.push_back(std::thread(work));
+        }
+    } catch (const std::exception &) {
+        // fewer helpers than asked for: the ones running and the caller cover the rest
+    }
+
+    work();
+    for (std::thread &helper : helpers) {
+        helper.join();
+    }
+    return failed ? (long long) SUDOKU_INTERNAL_ERROR : (long long) solved;
+}
+
+/**
+ * Checks a batch of same-size grids on the calling thread
+ *
+ * @return number of invalid boards, or SUDOKU_INVALID_ARGUMENT
+ */
+long long sudoku_validate_batch(const uint8_t *grids, int *statuses, size_t count,
+                                int side_length) {
+    if ((count > 0 && (!grids || !statuses)) || side_length <= 0 || side_length > 64) {
+        return SUDOKU_INVALID_ARGUMENT;
+    }
+
+    std::size_t cells = (std::size_t) side_length * side_length;
+    long long invalid = 0;
+    try {
+        for (std::size_t i = 0; i < count; ++i) {
+            statuses[i] = (int) validateGrid(grids + i * cells, side_length);
+            invalid += statuses[i] == SUDOKU_GRID_INVALID;
+        }
+    } catch (const std::bad_alloc &) {
+        return SUDOKU_INTERNAL_ERROR;
+    }
+    return invalid;
+}
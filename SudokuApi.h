@@ -0,0 +1,121 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef SUDOKU_API_H
+#define SUDOKU_API_H
+
+/**
+ * C interface of libsudoku. Every call works on caller-owned buffers of one byte per
+ * cell, row-major, 0 for an empty cell; nothing is copied into library-owned containers
+ * and nothing touches the file system. Boards are standard (rows, cols and square
+ * boxes) with a square side length up to 64. Every call is thread-safe: each thread
+ * solves on its own pooled context.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(SUDOKU_BUILDING_LIBRARY)
+#define SUDOKU_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#define SUDOKU_API __attribute__((visibility("default")))
+#else
+#define SUDOKU_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Results of the solve and count calls
+ */
+enum sudoku_result {
+    SUDOKU_OK = 0,                  /* solved, or counted */
+    SUDOKU_NO_SOLUTION = 1,         /* the puzzle has no solution or its givens conflict */
+    SUDOKU_INVALID_ARGUMENT = -1,   /* null buffer or unsupported side length */
+    SUDOKU_INTERNAL_ERROR = -2      /* out of memory */
+};
+
+/**
+ * Results of the validate calls
+ */
+enum sudoku_grid_status {
+    SUDOKU_GRID_COMPLETE = 0,       /* every cell filled and no unit repeats a value */
+    SUDOKU_GRID_PARTIAL = 1,        /* some cells empty, but no unit repeats a value */
+    SUDOKU_GRID_INVALID = 2         /* a unit repeats a value, or a value is out of range */
+};
+
+/**
+ * @return version of the library as "major.minor"
+ */
+SUDOKU_API const char *sudoku_version(void);
+
+/**
+ * Solves one puzzle
+ *
+ * @param puzzle (side_length * side_length values)
+ * @param side_length (rows and cols of the board: 4, 9, 16, ... up to 64)
+ * @param solution (set to the solution; may be the puzzle buffer itself; left untouched
+ * unless the result is SUDOKU_OK)
+ * @return SUDOKU_OK, SUDOKU_NO_SOLUTION or a negative error
+ */
+SUDOKU_API int sudoku_solve(const uint8_t *puzzle, int side_length, uint8_t *solution);
+
+/**
+ * Counts the solutions of one puzzle, stopping at a limit; a limit of 2 is the usual
+ * uniqueness check
+ *
+ * @param puzzle (side_length * side_length values)
+ * @param side_length (rows and cols of the board)
+ * @param limit (stop once this many solutions are found, 0 = count them all)
+ * @param count (set to the number of solutions, capped at limit)
+ * @return SUDOKU_OK, SUDOKU_NO_SOLUTION if the givens conflict, or a negative error
+ */
+SUDOKU_API int sudoku_count(const uint8_t *puzzle, int side_length, unsigned long long limit,
+                            unsigned long long *count);
+
+/**
+ * Checks a full or partial grid
+ *
+ * @param grid (side_length * side_length values)
+ * @param side_length (rows and cols of the board)
+ * @return a sudoku_grid_status, or SUDOKU_INVALID_ARGUMENT
+ */
+SUDOKU_API int sudoku_validate(const uint8_t *grid, int side_length);
+
+/**
+ * Solves a batch of same-size puzzles on worker threads
+ *
+ * @param puzzles (count boards of side_length * side_length values, back to back)
+ * @param solutions (output buffer of the same layout, may be puzzles itself;
+ * unsolvable boards are copied as given)
+ * @param results (set to the sudoku_result of each board, or NULL)
+ * @param count (number of boards)
+ * @param side_length (rows and cols of every board)
+ * @param thread_count (workers, 0 = one per hardware thread)
+ * @return number of boards solved, or a negative error
+ */
+SUDOKU_API long long sudoku_solve_batch(const uint8_t *puzzles, uint8_t *solutions,
+                                        int *results, size_t count, int side_length,
+                                        int thread_count);
+
+/**
+ * Checks a batch of same-size grids
+ *
+ * @param grids (count boards of side_length * side_length values, back to back)
+ * @param statuses (set to the sudoku_grid_status of each board)
+ * @param count (number of boards)
+ * @param side_length (rows and cols of every board)
+ * @return number of invalid boards, or SUDOKU_INVALID_ARGUMENT
+ */
+SUDOKU_API long long sudoku_validate_batch(const uint8_t *grids, int *statuses, size_t count,
+                                           int side_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ends SUDOKU_API_H */
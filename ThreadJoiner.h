@@ -0,0 +1,46 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef THREAD_JOINER_H
+#define THREAD_JOINER_H
+
+#include <thread>
+#include <vector>
+
+/**
+ * Joins a set of worker threads when it goes out of scope. Declared right after the
+ * vector the workers are started into, it makes a std::thread constructor throwing
+ * partway through the spawn loop unwind through joins of the workers already running,
+ * instead of destroying joinable threads and ending in std::terminate.
+ */
+class ThreadJoiner {
+
+public:
+    explicit ThreadJoiner(std::vector<std::thread> &threads) : threads(threads) {
+    }
+
+    ~ThreadJoiner() {
+        join();
+    }
+
+    /**
+    * Waits for every thread that is still joinable
+    */
+    void join() {
+        for (std::thread &thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+private:
+    std::vector<std::thread> &threads;
+
+    ThreadJoiner(const ThreadJoiner &) = delete;
+    ThreadJoiner &operator=(const ThreadJoiner &) = delete;
+};
+
+#endif // ends THREAD_JOINER_H
@@ -0,0 +1,67 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "TranspositionTable.h"
+
+/**
+ * @param log2_capacity (table holds 2^log2_capacity slots of 16 bytes)
+ */
+TranspositionTable::TranspositionTable(int log2_capacity)
+        : mask(((std::size_t) 1 << log2_capacity) - 1),
+          entries(new Entry[(std::size_t) 1 << log2_capacity]) {
+    clear();
+}
+
+/**
+ * Looks up the result stored for a board. The two halves of a slot are written
+ * separately, so a slot caught mid-write fails the check and reads as a miss.
+ *
+ * @param hash (Zobrist hash of the board)
+ * @param count (set to the stored number of solutions on a hit)
+ * @return true on a hit
+ */
+bool TranspositionTable::probe(uint64_t hash, unsigned long long &count) const {
+    const Entry &entry = entries[hash & mask];
+    uint64_t data = entry.data.load(std::memory_order_relaxed);
+    uint64_t check = entry.check.load(std::memory_order_relaxed);
+
+    if (data == 0 || (check ^ data) != hash) {
+        return false;
+    }
+
+    count = data - 1;
+    return true;
+}
+
+/**
+ * Stores the exact number of solutions below a board, 0 meaning unsatisfiable
+ *
+ * @param hash (Zobrist hash of the board)
+ * @param count (number of solutions)
+ */
+void TranspositionTable::store(uint64_t hash, unsigned long long count) {
+    Entry &entry = entries[hash & mask];
+    uint64_t data = count + 1;
+
+    entry.check.store(hash ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+/**
+ * Empties every slot. Not safe to run alongside probe or store.
+ */
+void TranspositionTable::clear() {
+    for (std::size_t x = 0; x <= mask; ++x) {
+        entries[x].check.store(0, std::memory_order_relaxed);
+        entries[x].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @return number of slots
+ */
+std::size_t TranspositionTable::getCapacity() const {
+    return mask + 1;
+}
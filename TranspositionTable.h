@@ -0,0 +1,74 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Fixed-size, lock-free memo of subtree results keyed by Zobrist hash. Each slot holds
+ * the result and the hash XORed with the result, so a reader can tell a slot torn by a
+ * concurrent writer (or owned by another board) from a real hit without any locking.
+ * Threads may share one table freely. New results always replace the slot's old one.
+ *
+ * Hashes describe which squares are filled and which values every unit of the board's
+ * RegionModel already holds, not the values themselves, so a table must only be shared
+ * between searches on the same RegionModel; call clear() before reusing it for another
+ * model.
+ */
+class TranspositionTable {
+
+public:
+    /**
+    * @param log2_capacity (table holds 2^log2_capacity slots of 16 bytes)
+    */
+    explicit TranspositionTable(int log2_capacity = 16);
+
+    /**
+    * Looks up the result stored for a board
+    *
+    * @param hash (Zobrist hash of the board)
+    * @param count (set to the stored number of solutions on a hit)
+    * @return true on a hit
+    */
+    bool probe(uint64_t hash, unsigned long long &count) const;
+
+    /**
+    * Stores the exact number of solutions below a board, 0 meaning unsatisfiable
+    *
+    * @param hash (Zobrist hash of the board)
+    * @param count (number of solutions)
+    */
+    void store(uint64_t hash, unsigned long long count);
+
+    /**
+    * Empties every slot. Not safe to run alongside probe or store.
+    */
+    void clear();
+
+    /**
+    * @return number of slots
+    */
+    std::size_t getCapacity() const;
+
+private:
+    /**
+     * One slot: data is the result plus one (so a zeroed slot never matches), check is
+     * hash ^ data
+     */
+    struct Entry {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    std::size_t mask;                  // capacity - 1, capacity is a power of two
+    std::unique_ptr<Entry[]> entries;
+};
+
+#endif // ends TRANSPOSITION_TABLE_H
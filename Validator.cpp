@@ -0,0 +1,193 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#include "Validator.h"
+#include "ThreadJoiner.h"
+#include <atomic>
+#include <cmath>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * Checks a standard grid in one pass over its squares. Each square's value becomes one
+ * bit that is tested against and then ORed into the masks of its row, col and box; any
+ * bit seen twice lands in repeated. The loops have no data-dependent branches and fixed
+ * trip counts, so the compiler unrolls them into straight-line mask operations.
+ */
+template<int BoxSize>
+GridStatus validateStandard(const uint8_t *cells) {
+    const int side_length = BoxSize * BoxSize;
+    uint32_t rows[side_length] = {0};
+    uint32_t cols[side_length] = {0};
+    uint32_t boxes[side_length] = {0};
+    uint32_t out_of_range = 0;
+    uint32_t empty = 0;
+    uint32_t repeated = 0;
+
+    for (int cell = 0; cell < side_length * side_length; ++cell) {
+        out_of_range |= cells[cell] > side_length;
+        empty |= cells[cell] == 0;
+    }
+    if (out_of_range) {                          // keeps the shifts below in range
+        return GridStatus::INVALID;
+    }
+
+    for (int row_number = 0; row_number < side_length; ++row_number) {
+        for (int col_number = 0; col_number < side_length; ++col_number) {
+            int box_number = row_number / BoxSize * BoxSize + col_number / BoxSize;
+            uint32_t bit = (1u << cells[row_number * side_length + col_number]) & ~1u;
+
+            repeated |= (rows[row_number] | cols[col_number] | boxes[box_number]) & bit;
+            rows[row_number] |= bit;
+            cols[col_number] |= bit;
+            boxes[box_number] |= bit;
+        }
+    }
+
+    if (repeated) {
+        return GridStatus::INVALID;
+    }
+    return empty ? GridStatus::PARTIAL : GridStatus::COMPLETE;
+}
+
+} // namespace
+
+/**
+ * Checks a full or partial grid on a standard board. 4 x 4, 9 x 9 and 16 x 16 grids
+ * take a fixed-size path specialized at compile time.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board, must be a square number)
+ * @return status of the grid (INVALID for unsupported sizes)
+ */
+GridStatus validateGrid(const uint8_t *cells, int side_length) {
+    switch (side_length) {
+        case 4:
+            return validateStandard<2>(cells);
+        case 9:
+            return validateStandard<3>(cells);
+        case 16:
+            return validateStandard<4>(cells);
+        default:
+            break;
+    }
+
+    int box_size = (int) (sqrt(side_length));
+    if (side_length <= 0 || side_length > 64 || box_size * box_size != side_length) {
+        return GridStatus::INVALID;
+    }
+
+    // larger standard models are built once per thread and size
+    static thread_local RegionModel model;
+    if (model.getSideLength() != side_length) {
+        model = RegionModel::standard(side_length);
+    }
+
+    return validateGrid(cells, model);
+}
+
+/**
+ * Checks a full or partial grid against a region model
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param regions (constraint model of the board, up to 64 x 64)
+ * @return status of the grid
+ */
+GridStatus validateGrid(const uint8_t *cells, const RegionModel &regions) {
+    int side_length = regions.getSideLength();
+    bool empty = false;
+
+    if (side_length <= 0 || side_length > 64) {
+        return GridStatus::INVALID;
+    }
+
+    for (int cell = 0; cell < regions.getCellCount(); ++cell) {
+        if (cells[cell] > side_length) {
+            return GridStatus::INVALID;
+        }
+        empty |= cells[cell] == 0;
+    }
+
+    uint64_t repeated = 0;
+    for (int unit = 0; unit < regions.getUnitCount(); ++unit) {
+        const int *unit_cells = regions.unitCells(unit);
+        uint64_t seen = 0;
+
+        for (int x = regions.unitSize(unit) - 1; x >= 0; --x) {
+            int val = cells[unit_cells[x]];
+            uint64_t bit = val ? 1ull << (val - 1) : 0;
+            repeated |= seen & bit;
+            seen |= bit;
+        }
+    }
+
+    if (repeated) {
+        return GridStatus::INVALID;
+    }
+    return empty ? GridStatus::PARTIAL : GridStatus::COMPLETE;
+}
+
+/**
+ * Checks a batch of same-size grids across threads. Each worker takes a contiguous
+ * slice, since every grid costs about the same. Slices whose worker cannot be started
+ * are checked on the calling thread.
+ *
+ * @param grids (count boards of side_length * side_length values, back to back)
+ * @param statuses (output, one status per board)
+ * @param count (number of boards)
+ * @param side_length (number of rows and cols on every board)
+ * @param thread_count (worker threads, 0 for one per hardware thread)
+ * @return number of boards that are not INVALID
+ */
+std::size_t validateBatch(const uint8_t *grids, GridStatus *statuses, std::size_t count,
+                          int side_length, int thread_count) {
+    std::size_t cells = (std::size_t) side_length * side_length;
+    std::atomic<std::size_t> valid(0);
+    std::vector<std::thread> workers;
+    ThreadJoiner joiner(workers);
+
+    if (thread_count <= 0) {
+        thread_count = (int) std::thread::hardware_concurrency();
+        thread_count = thread_count > 0 ? thread_count : 1;
+    }
+
+    // small batches are not worth a thread start
+    if ((std::size_t) thread_count > count / 4096 + 1) {
+        thread_count = (int) (count / 4096 + 1);
+    }
+
+    std::size_t slice = (count + thread_count - 1) / thread_count;
+    auto work = [&](int x) {
+        std::size_t first = x * slice < count ? x * slice : count;
+        std::size_t last = first + slice < count ? first + slice : count;
+        std::size_t slice_valid = 0;
+        for (std::size_t i = first; i < last; ++i) {
+            statuses[i] = validateGrid(grids + i * cells, side_length);
+            slice_valid += statuses[i] != GridStatus::INVALID;
+        }
+        valid += slice_valid;
+    };
+
+    int started = 1;
+    workers.reserve(thread_count - 1);           // push_back must not throw once started
+    try {
+        for (; started < thread_count; ++started) {
+            workers.push_back(std::thread(work, started));
+        }
+    } catch (const std::system_error &) {
+        // slices whose worker could not start are left to the calling thread
+    }
+
+    work(0);                                     // the calling thread takes the first slice
+    for (int x = started; x < thread_count; ++x) {
+        work(x);
+    }
+
+    joiner.join();
+    return valid;
+}
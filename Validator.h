@@ -0,0 +1,55 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/18/2026
+ *************************************************************************************/
+
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "RegionModel.h"
+
+/**
+ * Outcome of checking a grid against the rules
+ */
+enum class GridStatus {
+    COMPLETE,   // every square filled and no unit repeats a value
+    PARTIAL,    // some squares empty, but no unit repeats a value
+    INVALID     // a unit repeats a value, or a value is out of range
+};
+
+/**
+ * Checks a full or partial grid on a standard board. 4 x 4, 9 x 9 and 16 x 16 grids
+ * take a fixed-size path specialized at compile time.
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param side_length (number of rows and cols on the board, must be a square number)
+ * @return status of the grid (INVALID for unsupported sizes)
+ */
+GridStatus validateGrid(const uint8_t *cells, int side_length);
+
+/**
+ * Checks a full or partial grid against a region model
+ *
+ * @param cells (side_length * side_length values in row-major order, 0 for empty)
+ * @param regions (constraint model of the board, up to 64 x 64)
+ * @return status of the grid
+ */
+GridStatus validateGrid(const uint8_t *cells, const RegionModel &regions);
+
+/**
+ * Checks a batch of same-size grids across threads. Slices whose worker cannot be
+ * started are checked on the calling thread.
+ *
+ * @param grids (count boards of side_length * side_length values, back to back)
+ * @param statuses (output, one status per board)
+ * @param count (number of boards)
+ * @param side_length (number of rows and cols on every board)
+ * @param thread_count (worker threads, 0 for one per hardware thread)
+ * @return number of boards that are not INVALID
+ */
+std::size_t validateBatch(const uint8_t *grids, GridStatus *statuses, std::size_t count,
+                          int side_length, int thread_count = 0);
+
+#endif // ends VALIDATOR_H
@@ -0,0 +1,368 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#include "WorkerPool.h"
+#include "LockstepBatch.h"
+#include "SolverContext.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+/**
+ * @return first line of a small text file, empty if it cannot be read
+ */
+std::string readLine(const std::string &path) {
+    char buffer[4096];
+    FILE *file = fopen(path.c_str(), "r");
+    if (!file) {
+        return std::string();
+    }
+
+    std::string line = fgets(buffer, sizeof(buffer), file) ? buffer : "";
+    fclose(file);
+    if (!line.empty() && line.back() == '\n') {
+        line.pop_back();
+    }
+    return line;
+}
+
+/**
+ * @return CPUs the calling process may run on, ascending
+ */
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+
+    if (cpus.empty()) {
+        int count = (int) std::thread::hardware_concurrency();
+        for (int cpu = 0; cpu < (count > 0 ? count : 1); ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+/**
+ * Binds the calling thread to a set of CPUs; a no-op where affinity is not supported
+ * or the set is empty
+ */
+void pinThread(const std::vector<int> &cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (CPU_COUNT(&set) > 0) {
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    (void) cpus;
+#endif
+}
+
+} // namespace
+
+/**
+ * @return CPU ids of a Linux cpulist such as "0-3,8,10-11", empty if malformed
+ */
+std::vector<int> parseCpuList(const std::string &list) {
+    std::vector<int> cpus;
+    const char *next = list.c_str();
+
+    while (*next != '\0') {
+        char *end;
+        long first = std::strtol(next, &end, 10);
+        long last = first;
+        if (end == next || first < 0) {
+            return std::vector<int>();
+        }
+
+        if (*end == '-') {
+            next = end + 1;
+            last = std::strtol(next, &end, 10);
+            if (end == next || last < first) {
+                return std::vector<int>();
+            }
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back((int) cpu);
+        }
+
+        if (*end == ',') {
+            ++end;
+        } else if (*end != '\0' && *end != '\n') {
+            return std::vector<int>();
+        }
+        next = *end == '\n' ? "" : end;
+    }
+
+    return cpus;
+}
+
+/**
+ * Reads the online nodes and their cpulists from sysfs and keeps the CPUs the process
+ * may run on. Anything missing or unreadable falls back to one node of all allowed CPUs.
+ *
+ * @return topology read from /sys/devices/system/node on Linux, one node elsewhere
+ */
+Topology Topology::detect() {
+    Topology topology;
+    std::vector<int> allowed = allowedCpus();
+    std::vector<bool> usable;
+    for (int cpu : allowed) {
+        if ((int) usable.size() <= cpu) {
+            usable.resize(cpu + 1, false);
+        }
+        usable[cpu] = true;
+    }
+
+#ifdef __linux__
+    const std::string root = "/sys/devices/system/node/";
+    for (int node : parseCpuList(readLine(root + "online"))) {
+        std::vector<int> cpus;
+        std::string list = readLine(root + "node" + std::to_string(node) + "/cpulist");
+
+        for (int cpu : parseCpuList(list)) {
+            if (cpu < (int) usable.size() && usable[cpu]) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            topology.node_cpus.push_back(cpus);
+        }
+    }
+#endif
+
+    if (topology.node_cpus.empty()) {
+        topology.node_cpus.push_back(allowed);
+    }
+    return topology;
+}
+
+/**
+ * @return number of CPUs over all nodes
+ */
+int Topology::cpuCount() const {
+    int count = 0;
+    for (const std::vector<int> &cpus : node_cpus) {
+        count += (int) cpus.size();
+    }
+    return count;
+}
+
+/**
+ * Pins the calling thread as worker number index of a pool: worker w goes to node
+ * w % nodes and, with CORE pinning, to the (w / nodes)-th CPU of that node, wrapping
+ * around when there are more workers than CPUs
+ *
+ * @param topology (nodes and CPUs to place the worker on, at least one node)
+ * @param pinning (CPU binding to apply)
+ * @param index (number of the worker)
+ * @return node of the worker
+ */
+int placeWorker(const Topology &topology, Pinning pinning, int index) {
+    int nodes = (int) topology.node_cpus.size();
+    int node = index % nodes;
+    const std::vector<int> &cpus = topology.node_cpus[node];
+
+    if (pinning == Pinning::NODE) {
+        pinThread(cpus);
+    } else if (pinning == Pinning::CORE && !cpus.empty()) {
+        pinThread(std::vector<int>(1, cpus[(index / nodes) % cpus.size()]));
+    }
+    return node;
+}
+
+/**
+ * Starts the workers, placed as placeWorker describes.
+ *
+ * @param config (thread count, pinning and chunk size)
+ * @param topology (nodes and CPUs to place workers on)
+ */
+WorkerPool::WorkerPool(const PoolConfig &config, const Topology &topology)
+        : config(config), topology(topology), generation(0), running(0), stopping(false),
+          puzzles(nullptr), solutions(nullptr), side_length(0), solved(0) {
+    if (this->topology.node_cpus.empty()) {
+        this->topology.node_cpus.push_back(allowedCpus());
+    }
+    if (this->config.thread_count <= 0) {
+        this->config.thread_count = this->topology.cpuCount();
+    }
+    if (this->config.chunk == 0) {
+        this->config.chunk = 1;
+    }
+
+    queues = std::vector<NodeQueue>(this->topology.node_cpus.size());
+    for (int x = 0; x < this->config.thread_count; ++x) {
+        workers.push_back(std::thread(&WorkerPool::work, this, x));
+    }
+}
+
+/**
+ * Stops and joins the workers
+ */
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Solves a batch of same-size puzzles on the workers. Each node's queue gets a
+ * contiguous range of the batch in proportion to the workers on that node.
+ *
+ * @param puzzles (count boards of side_length * side_length values, back to back)
+ * @param solutions (output buffer of the same layout; unsolvable boards are left as given)
+ * @param count (number of boards)
+ * @param side_length (number of rows and cols on every board)
+ * @return number of boards solved
+ */
+std::size_t WorkerPool::solveBatch(const uint8_t *puzzles, uint8_t *solutions,
+                                   std::size_t count, int side_length) {
+    std::lock_guard<std::mutex> batch_guard(batch_mutex);
+    int nodes = getNodeCount();
+    int threads = getThreadCount();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    this->puzzles = puzzles;
+    this->solutions = solutions;
+    this->side_length = side_length;
+    solved = 0;
+
+    std::size_t begin = 0;
+    int workers_before = 0;
+    for (int node = 0; node < nodes; ++node) {
+        workers_before += threads / nodes + (node < threads % nodes ? 1 : 0);
+        queues[node].next = begin;
+        queues[node].end = count * (std::size_t) workers_before / (std::size_t) threads;
+        begin = queues[node].end;
+    }
+
+    running = threads;
+    ++generation;
+    wake.notify_all();
+    done.wait(lock, [this]() { return running == 0; });
+
+    return solved;
+}
+
+/**
+ * @return number of worker threads
+ */
+int WorkerPool::getThreadCount() const {
+    return config.thread_count;
+}
+
+/**
+ * @return number of NUMA nodes the workers are spread over
+ */
+int WorkerPool::getNodeCount() const {
+    return (int) topology.node_cpus.size();
+}
+
+/**
+ * Body of worker number index: pins itself, then leases its solver context, takes its
+ * thread's lockstep engine and allocates its puzzle buffer so all three are first
+ * touched on its node, then serves batches until the pool stops
+ */
+void WorkerPool::work(int index) {
+    int node = placeWorker(topology, config.pinning, index);
+    SolverPool::Lease context = SolverPool::acquire();
+    LockstepBatch &lockstep = SolverPool::lockstep();
+    std::vector<uint8_t> buffer;
+    unsigned long long seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        solved += drain(node, buffer, *context, lockstep);
+
+        std::lock_guard<std::mutex> guard(mutex);
+        if (--running == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+/**
+ * Solves every chunk the worker can claim, own node first. Each chunk is copied into
+ * the worker's node-local buffer before solving, so the search never reads the
+ * caller's memory, wherever it lives. 9 x 9 chunks go through the worker's
+ * LockstepBatch.
+ *
+ * @return puzzles solved by the worker
+ */
+std::size_t WorkerPool::drain(int node, std::vector<uint8_t> &buffer,
+                              SolverContext &context, LockstepBatch &lockstep) {
+    std::size_t cells = (std::size_t) side_length * side_length;
+    std::size_t count = 0;
+    int nodes = getNodeCount();
+    buffer.resize(config.chunk * cells);
+
+    for (int offset = 0; offset < nodes; ++offset) {
+        NodeQueue &queue = queues[(node + offset) % nodes];
+
+        for (std::size_t first = queue.next.fetch_add(config.chunk); first < queue.end;
+             first = queue.next.fetch_add(config.chunk)) {
+            std::size_t last = first + config.chunk;
+            last = last < queue.end ? last : queue.end;
+            std::memcpy(buffer.data(), puzzles + first * cells, (last - first) * cells);
+
+            if (side_length == LockstepBatch::SIDE) {
+                count += lockstep.solve(context, buffer.data(), solutions + first * cells,
+                                        last - first);
+                continue;
+            }
+
+            for (std::size_t i = first; i < last; ++i) {
+                const uint8_t *puzzle = buffer.data() + (i - first) * cells;
+
+                if (context.arm(puzzle, side_length) &&
+                    context.solve(SearchOptions::forSide(side_length))) {
+                    context.storeCells(solutions + i * cells);
+                    ++count;
+                } else {
+                    std::memcpy(solutions + i * cells, puzzle, cells);
+                }
+            }
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,174 @@
+/*************************************************************************************
+ * Name: Vishnu Pydah
+ * Date: 10/19/2026
+ *************************************************************************************/
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class LockstepBatch;
+class SolverContext;
+
+/**
+ * How the workers of a WorkerPool are tied to CPUs
+ */
+enum class Pinning {
+    NONE,     // threads run wherever the scheduler puts them
+    NODE,     // each worker may run on any CPU of its NUMA node, but no other
+    CORE      // each worker is bound to a single CPU of its node
+};
+
+/**
+ * Settings of a WorkerPool
+ */
+struct PoolConfig {
+    int thread_count;      // workers, 0 = one per CPU the process may run on
+    Pinning pinning;       // CPU binding of the workers
+    std::size_t chunk;     // puzzles a worker takes from a queue at a time
+
+    PoolConfig() : thread_count(0), pinning(Pinning::NODE), chunk(64) {
+    }
+};
+
+/**
+ * CPUs of each NUMA node, limited to the CPUs the process may run on. Machines (or
+ * platforms) without NUMA information show up as a single node.
+ */
+struct Topology {
+    std::vector<std::vector<int>> node_cpus;   // CPU ids of each node, nodes without any
+                                               // usable CPU left out
+
+    /**
+    * @return topology read from /sys/devices/system/node on Linux, one node elsewhere
+    */
+    static Topology detect();
+
+    /**
+    * @return number of CPUs over all nodes
+    */
+    int cpuCount() const;
+};
+
+/**
+ * @return CPU ids of a Linux cpulist such as "0-3,8,10-11", empty if malformed
+ */
+std::vector<int> parseCpuList(const std::string &list);
+
+/**
+ * Pins the calling thread as worker number index of a pool: worker w goes to node
+ * w % nodes and, with CORE pinning, to the (w / nodes)-th CPU of that node, wrapping
+ * around when there are more workers than CPUs
+ *
+ * @param topology (nodes and CPUs to place the worker on, at least one node)
+ * @param pinning (CPU binding to apply)
+ * @param index (number of the worker)
+ * @return node of the worker
+ */
+int placeWorker(const Topology &topology, Pinning pinning, int index);
+
+/**
+ * Persistent batch-solving threads spread evenly over the NUMA nodes of the machine.
+ *
+ * Worker w belongs to node w % nodes and is pinned according to the config before it
+ * does anything else, so the solver context it then leases (and its buffer of copied
+ * puzzles) is first touched, and therefore allocated, on its own node. A batch is split
+ * into one contiguous queue per node, sized by the node's share of the workers; workers
+ * take chunks from their own node's queue and only then help drain the other nodes',
+ * so boards cross the interconnect only when a node runs ahead of the rest.
+ */
+class WorkerPool {
+
+public:
+    /**
+    * Starts the workers
+    *
+    * @param config (thread count, pinning and chunk size)
+    * @param topology (nodes and CPUs to place workers on)
+    */
+    explicit WorkerPool(const PoolConfig &config = PoolConfig(),
+                        const Topology &topology = Topology::detect());
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+    * Stops and joins the workers
+    */
+    ~WorkerPool();
+
+    /**
+    * Solves a batch of same-size puzzles on the workers. Calls from several threads are
+    * served one batch at a time.
+    *
+    * @param puzzles (count boards of side_length * side_length values, back to back)
+    * @param solutions (output buffer of the same layout; unsolvable boards are left as given)
+    * @param count (number of boards)
+    * @param side_length (number of rows and cols on every board)
+    * @return number of boards solved
+    */
+    std::size_t solveBatch(const uint8_t *puzzles, uint8_t *solutions, std::size_t count,
+                           int side_length);
+
+    /**
+    * @return number of worker threads
+    */
+    int getThreadCount() const;
+
+    /**
+    * @return number of NUMA nodes the workers are spread over
+    */
+    int getNodeCount() const;
+
+private:
+    /**
+     * Unclaimed part of a node's share of the current batch, padded to a cache line so
+     * nodes do not contend on each other's cursors
+     */
+    struct NodeQueue {
+        std::atomic<std::size_t> next;
+        std::size_t end;
+        char padding[64 - 2 * sizeof(std::size_t)];
+    };
+
+    PoolConfig config;
+    Topology topology;
+    std::vector<NodeQueue> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex batch_mutex;            // one batch at a time
+    std::mutex mutex;                  // guards the fields below
+    std::condition_variable wake;      // a batch was posted or the pool is stopping
+    std::condition_variable done;      // the last worker finished the batch
+    unsigned long long generation;     // batches posted so far
+    int running;                       // workers still busy with the current batch
+    bool stopping;
+
+    const uint8_t *puzzles;            // current batch
+    uint8_t *solutions;
+    int side_length;
+    std::atomic<std::size_t> solved;
+
+    /**
+    * Body of worker number index
+    */
+    void work(int index);
+
+    /**
+    * Solves every chunk the worker can claim, own node first
+    *
+    * @return puzzles solved by the worker
+    */
+    std::size_t drain(int node, std::vector<uint8_t> &buffer, SolverContext &context,
+                      LockstepBatch &lockstep);
+};
+
+#endif // ends WORKER_POOL_H
@@ -1,11 +1,62 @@
 //courtesy of Roth
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <time.h>
+#include <unistd.h>
+#include <vector>
 #include "Sudoku.h"
+#include "BandCounter.h"
+#include "Cli.h"
+#include "Generator.h"
+#include "Histogram.h"
+#include "Job.h"
+#include "LockstepBatch.h"
+#include "Pipeline.h"
+#include "Portfolio.h"
+#include "Rater.h"
+#include "RegionModel.h"
+#include "RingQueue.h"
+#include "SatSudoku.h"
+#include "SearchObserver.h"
+#include "SolverContext.h"
+#include "SudokuApi.h"
+#include "Validator.h"
+#include "WorkerPool.h"
+
+// loads a board file into a flat cell buffer and returns its side length
+static int loadCells(const std::string &filename, std::vector<uint8_t> &cells) {
+   Sudoku board;
+   board.loadFromFile(filename);
+   int side = board.getSideLength();
+   cells.resize(side * side);
+   board.storeCells(cells.data());
+   return side;
+}
+
+// checks that a full board has no empty squares and no repeats in any unit of the model
+static bool satisfies(const RegionModel &model, const std::vector<uint8_t> &cells) {
+   for (int unit = 0; unit < model.getUnitCount(); ++unit) {
+      std::vector<bool> seen(model.getSideLength() + 1, false);
+      for (int x = 0; x < model.unitSize(unit); ++x) {
+         int val = cells[model.unitCells(unit)[x]];
+         if (val == 0 || seen[val]) {
+            return false;
+         }
+         seen[val] = true;
+      }
+   }
+   return true;
+}
 
 int main(int argc, char * argv[]) {
+   if (argc > 1) {   // command-line tools, e.g. "validate grids.txt"
+      return runCli(argc, argv);
+   }
+
    std::string ans, filename;
    Sudoku puzzle;
    Sudoku solution;
@@ -74,6 +125,910 @@ int main(int argc, char * argv[]) {
       std::cout << " seconds." << std::endl;
    } 
 
+   std::cout << "\nRunning Pooled Context Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // every puzzle goes through the same re-armed context, as in batch mode
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      int side = loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+
+      SolverPool::Lease context = SolverPool::acquire();
+      bool solved = context->arm(cells.data(), side) && context->solve();
+      context->storeCells(cells.data());
+
+      std::cout << "context " << infile[i] << ": ";
+      if (solved != (i != num-2) || (solved && cells != expected)) {
+         std::cout << "Fail ++++++++++++++++++++++" << std::endl;
+      } else {
+         std::cout << "Pass (" << context->getNodeCount() << " nodes)" << std::endl;
+      }
+   }
+
+   std::cout << "\nRunning Portfolio Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   std::vector<PortfolioConfig> portfolio = defaultPortfolio();
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      int side = loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+
+      std::vector<uint8_t> board(cells.size(), 0);
+      PortfolioResult result = solvePortfolio(cells.data(), side, board.data(), portfolio);
+
+      std::cout << "portfolio " << infile[i] << ": ";
+      if (result.winner < 0 || result.solved != (i != num-2) ||
+          (result.solved && board != expected)) {
+         std::cout << "Fail ++++++++++++++++++++++" << std::endl;
+      } else {
+         std::cout << "Pass (" << portfolio[result.winner].name << ")" << std::endl;
+      }
+   }
+
+   std::cout << "\nRunning Value Order Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   const ValueOrder orders[] = {ValueOrder::ASCENDING, ValueOrder::LEAST_CONSTRAINING,
+                                ValueOrder::FREQUENCY, ValueOrder::RANDOM};
+   for (int i = 0; i < num; i++) {
+      std::cout << infile[i] << ":";
+      for (ValueOrder order : orders) {
+         puzzle.loadFromFile(infile[i]);
+         solution.loadFromFile(outfile[i]);
+
+         bool solved = puzzle.solve(order, 1);
+         const SearchStats &stats = puzzle.getStats();
+         if (solved != (i != num-2) || (solved && !puzzle.equals(solution))) {
+            std::cout << " Fail ++++++++++++++++++++++";
+         }
+         std::cout << " " << valueOrderName(stats.value_order) << "=" << stats.nodes
+                   << "/" << stats.backjumps;
+      }
+      std::cout << std::endl;
+   }
+
+   // backjumping skips branches a chronological search would still expand, so on
+   // puzzles with deep conflicts it must jump and search fewer nodes
+   for (int i = 0; i < num; i++) {
+      puzzle.loadFromFile(infile[i]);
+      puzzle.beginSearch(ValueOrder::ASCENDING, 0, false);
+      SearchStatus chronological = puzzle.continueSearch();
+      SearchStats plain = puzzle.getStats();
+      puzzle.loadFromFile(infile[i]);
+      bool jumped = puzzle.solve(ValueOrder::ASCENDING);
+      const SearchStats &stats = puzzle.getStats();
+
+      bool deep = plain.nodes >= 500;   // sudoku-hard2, the diabolic puzzles, curtis2
+      bool jump_ok = jumped == (chronological == SearchStatus::SOLVED) &&
+                     plain.backjumps == 0 && stats.nodes <= plain.nodes &&
+                     (!deep || (stats.backjumps > 0 && stats.nodes < plain.nodes));
+      std::cout << "backjump " << infile[i] << ": "
+                << (jump_ok ? "Pass" : "Fail ++++++++++++++++++++++") << " ("
+                << stats.nodes << " vs " << plain.nodes << " chronological nodes)"
+                << std::endl;
+   }
+
+   std::cout << "\nRunning Checkpoint Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // suspends every 200 nodes and continues in a fresh object restored from the saved
+   // state; the search must end exactly like one uninterrupted solve
+   for (int i = 0; i < num; i++) {
+      puzzle.loadFromFile(infile[i]);
+      puzzle.solve(ValueOrder::RANDOM, 3);
+      SearchStats straight = puzzle.getStats();
+      std::vector<uint8_t> straight_cells(81);
+      puzzle.storeCells(straight_cells.data());
+
+      Sudoku *current = new Sudoku();
+      current->loadFromFile(infile[i]);
+      current->beginSearch(ValueOrder::RANDOM, 3);
+      int suspensions = 0;
+      std::vector<uint8_t> state;
+
+      SearchStatus status;
+      while ((status = current->continueSearch(200)) == SearchStatus::SUSPENDED) {
+         current->saveSearch(state);
+         delete current;
+         current = new Sudoku();
+         if (!current->loadSearch(state)) {
+            break;
+         }
+         ++suspensions;
+      }
+
+      const SearchStats &resumed = current->getStats();
+      std::vector<uint8_t> resumed_cells(81);
+      current->storeCells(resumed_cells.data());
+      bool same = status == (i == num-2 ? SearchStatus::UNSOLVABLE : SearchStatus::SOLVED) &&
+                  resumed.nodes == straight.nodes && resumed.backtracks == straight.backtracks &&
+                  resumed.backjumps == straight.backjumps && resumed_cells == straight_cells;
+      delete current;
+
+      std::cout << infile[i] << ": " << (same ? "Pass" : "Fail ++++++++++++++++++++++")
+                << " (" << suspensions << " restores)" << std::endl;
+   }
+
+   // a truncated checkpoint is rejected
+   puzzle.loadFromFile(infile[3]);
+   puzzle.beginSearch();
+   puzzle.continueSearch(10);
+   std::vector<uint8_t> checkpoint;
+   puzzle.saveSearch(checkpoint);
+   checkpoint.pop_back();
+   std::cout << "truncated checkpoint: "
+             << (!solution.loadSearch(checkpoint) ? "Pass" : "Fail ++++++++++++++++++++++")
+             << std::endl;
+
+   std::cout << "\nRunning Restart Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   const RestartPolicy policies[] = {RestartPolicy::LUBY, RestartPolicy::GEOMETRIC};
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      int side = loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+
+      std::cout << infile[i] << ":";
+      for (RestartPolicy policy : policies) {
+         SearchOptions options;
+         options.value_order = ValueOrder::RANDOM;
+         options.restarts = policy;
+         options.restart_base = 16;
+         options.seed = 7;
+
+         std::vector<uint8_t> board(cells.size());
+         SolverPool::Lease context = SolverPool::acquire();
+         bool solved = context->arm(cells.data(), side) && context->solve(options);
+         context->storeCells(board.data());
+
+         if (solved != (i != num-2) || (solved && board != expected)) {
+            std::cout << " Fail ++++++++++++++++++++++";
+         }
+         std::cout << " " << (policy == RestartPolicy::LUBY ? "luby" : "geometric") << "="
+                   << context->getStats().nodes << "/" << context->getStats().restarts;
+      }
+      std::cout << std::endl;
+   }
+
+   std::cout << "\nRunning Matching Filter Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // the impossible puzzle is refuted before any decision
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      int side = loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+
+      SearchOptions options;
+      options.matching = true;
+      std::vector<uint8_t> board(cells.size());
+      SolverPool::Lease context = SolverPool::acquire();
+      bool solved = context->arm(cells.data(), side) && context->solve(options);
+      context->storeCells(board.data());
+
+      bool matching_ok = solved == (i != num-2) && (!solved || board == expected) &&
+                         (solved || context->getStats().nodes == 0);
+      std::cout << infile[i] << ": " << (matching_ok ? "Pass" : "Fail ++++++++++++++++++++++")
+                << " (" << context->getStats().nodes << " nodes, "
+                << context->getStats().pruned << " pruned)" << std::endl;
+   }
+
+   std::cout << "\nRunning Solution Count Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   for (int i = 0; i < num; i++) {
+      puzzle.loadFromFile(infile[i]);
+      unsigned long long count = puzzle.countSolutions(2);
+      std::cout << "count " << infile[i] << ": "
+                << (count == (i != num-2 ? 1u : 0u) ? "Pass" : "Fail ++++++++++++++++++++++")
+                << " (" << count << ")" << std::endl;
+   }
+
+   // every 4 x 4 grid, then a capped count of the empty 9 x 9 grid through a shared table
+   std::vector<uint8_t> empty_cells(16, 0);
+   TranspositionTable shared_table;
+   SolverPool::Lease counter = SolverPool::acquire();
+   counter->arm(empty_cells.data(), 4);
+   unsigned long long small_count = counter->countSolutions(0, shared_table);
+   std::cout << "count empty 4 x 4: "
+             << (small_count == 288 ? "Pass" : "Fail ++++++++++++++++++++++") << " (" << small_count << ", " << counter->getStats().nodes << " nodes)" << std::endl;
+
+   shared_table.clear();
+   empty_cells.assign(81, 0);
+   counter->arm(empty_cells.data(), 9);
+   unsigned long long capped_count = counter->countSolutions(1000, shared_table);
+   std::cout << "count empty 9 x 9 up to 1000: "
+             << (capped_count == 1000 ? "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   std::cout << "\nRunning Edit Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // edits the first open square of test1: a wrong value, its value from the solution,
+   // then a repeat of a value already in its row
+   puzzle.loadFromFile(infile[0]);
+   std::vector<uint8_t> edit_solution;
+   loadCells(outfile[0], edit_solution);
+
+   int open_cell = 0;
+   std::vector<uint8_t> edit_cells(81);
+   puzzle.storeCells(edit_cells.data());
+   while (edit_cells[open_cell] != 0) {
+      ++open_cell;
+   }
+
+   int row = open_cell / 9, col = open_cell % 9;
+   int right = edit_solution[open_cell];
+   uint64_t open_mask = puzzle.getCandidates(row, col);
+   int wrong = 0;
+   for (int val = 1; val <= 9; val++) {
+      if (val != right && (open_mask & (1ull << (val - 1)))) {
+         wrong = val;
+      }
+   }
+
+   bool edits_ok = puzzle.isValid() && puzzle.isSolvable();
+   edits_ok = edits_ok && (wrong == 0 || (puzzle.setCell(row, col, wrong) &&
+                                           puzzle.isValid() &&
+                                           puzzle.checkSolvable() != SearchStatus::SOLVED &&
+                                           !puzzle.isSolvable()));
+   edits_ok = edits_ok && puzzle.setCell(row, col, right) &&
+              puzzle.checkSolvable() == SearchStatus::SOLVED && puzzle.isSolvable();
+   puzzle.clearCell(row, col);
+   edits_ok = edits_ok && puzzle.isSolvable() &&
+              (puzzle.getCandidates(row, col) & (1ull << (right - 1)));
+
+   int taken = 0;
+   for (int y = 0; y < 9; y++) {
+      if (edit_cells[row * 9 + y] != 0) {
+         taken = edit_cells[row * 9 + y];
+      }
+   }
+   edits_ok = edits_ok && puzzle.setCell(row, col, taken) && !puzzle.isValid() &&
+              !puzzle.isSolvable();
+   puzzle.clearCell(row, col);
+   edits_ok = edits_ok && puzzle.isValid() && puzzle.isSolvable() &&
+              !puzzle.setCell(row, col, 10);
+   edits_ok = edits_ok && puzzle.getCandidates(9, 0) == 0 &&
+              puzzle.getCandidates(0, -1) == 0;
+
+   std::cout << "edit " << infile[0] << ": "
+             << (edits_ok ? "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   // boards past the 64-bit value masks are refused at load time
+   Sudoku wide_board;
+   std::vector<uint8_t> wide_cells(81 * 81, 0);
+   wide_board.loadFromCells(wide_cells.data(), 81);
+   std::vector<char> wide_text(formattedSize(9, GridStyle::PRETTY));
+   bool wide_ok = wide_board.getSideLength() == 9 && !wide_board.setCell(0, 0, 70) &&
+                  wide_board.format(wide_text.data(), GridStyle::PRETTY) > 0;
+   std::cout << "edit 81 x 81: "
+             << (wide_ok ? "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   std::cout << "\nRunning Logical Step Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // applies hints until none is left; no hint may contradict the known solution
+   Step step;
+   for (int i = 0; i < num; i++) {
+      if (i == num-2) {
+         continue;
+      }
+
+      std::vector<uint8_t> expected;
+      loadCells(outfile[i], expected);
+      puzzle.loadFromFile(infile[i]);
+
+      bool steps_ok = true;
+      int step_count = 0;
+      std::string first_step;
+      while (puzzle.nextStep(step)) {
+         if (first_step.empty()) {
+            first_step = describeStep(step, RegionModel::standard(9));
+         }
+         if (step.value != 0 && step.value != expected[step.cells[0]]) {
+            steps_ok = false;
+         }
+         for (const std::pair<int, uint64_t> &elimination : step.eliminations) {
+            if (elimination.second & (1ull << (expected[elimination.first] - 1))) {
+               steps_ok = false;
+            }
+         }
+         puzzle.applyStep(step);
+         step_count++;
+      }
+
+      std::vector<uint8_t> reached(81);
+      puzzle.storeCells(reached.data());
+      int still_open = 0;
+      for (int x = 0; x < 81; x++) {
+         still_open += reached[x] == 0;
+      }
+
+      std::cout << "steps " << infile[i] << ": "
+                << (steps_ok ? "Pass" : "Fail ++++++++++++++++++++++") << " (" << step_count
+                << " steps, " << still_open << " squares left; first: " << first_step << ")"
+                << std::endl;
+   }
+
+   // boxes are named after the box they cover; jigsaw regions and extra units are not
+   std::vector<uint8_t> row_regions(16);
+   for (int x = 0; x < 16; x++) {
+      row_regions[x] = x / 4;
+   }
+   Step named;
+   named.technique = Step::HIDDEN_PAIR;
+   named.values = 3;
+   named.unit = 24;
+   std::string box_name = describeStep(named, RegionModel::standard(9));
+   named.unit = 27;
+   std::string extra_name = describeStep(named, RegionModel::diagonal(9));
+   named.unit = 9;
+   std::string jigsaw_name = describeStep(named, RegionModel::jigsaw(4, row_regions.data()));
+   bool names_ok = box_name.find(" in box 7:") != std::string::npos &&
+                   extra_name.find(" in region 1:") != std::string::npos &&
+                   jigsaw_name.find(" in region 2:") != std::string::npos;
+   std::cout << "unit names: " << (names_ok ? "Pass" : "Fail ++++++++++++++++++++++")
+             << " (" << jigsaw_name << ")" << std::endl;
+
+   std::cout << "\nRunning Rating Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // every puzzle rated alone, then all of them again through the threaded batch
+   std::vector<uint8_t> rating_batch;
+   std::vector<Rating> ratings(num);
+   Rater rater;
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells;
+      loadCells(infile[i], cells);
+      rating_batch.insert(rating_batch.end(), cells.begin(), cells.end());
+      ratings[i] = rater.rate(cells.data(), 9);
+
+      std::cout << "rate " << infile[i] << ": "
+                << (ratings[i].solved == (i != num-2) ? "Pass" : "Fail ++++++++++++++++++++++")
+                << " (score " << ratings[i].score << ", " << techniqueName(ratings[i].hardest)
+                << ", " << ratings[i].steps << " steps, " << ratings[i].guesses << " guesses)"
+                << std::endl;
+   }
+
+   std::vector<Rating> batch_ratings(num);
+   rateBatch(rating_batch.data(), batch_ratings.data(), num, 9, 4);
+   bool ratings_match = true;
+   for (int i = 0; i < num; i++) {
+      ratings_match = ratings_match && batch_ratings[i].score == ratings[i].score &&
+                      batch_ratings[i].solved == ratings[i].solved;
+   }
+   std::cout << "rate batch: " << (ratings_match ? "Pass" : "Fail ++++++++++++++++++++++")
+             << std::endl;
+
+   std::cout << "\nRunning Validator Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // solutions are complete, puzzles partial, and a solution with two squares swapped
+   // within a row is invalid
+   std::vector<uint8_t> check_grids;
+   std::vector<GridStatus> check_expected;
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+
+      check_grids.insert(check_grids.end(), expected.begin(), expected.end());
+      check_expected.push_back(GridStatus::COMPLETE);
+      check_grids.insert(check_grids.end(), cells.begin(), cells.end());
+      check_expected.push_back(GridStatus::PARTIAL);   // unsolvable is still rule-abiding
+
+      std::swap(expected[0], expected[9]);
+      check_grids.insert(check_grids.end(), expected.begin(), expected.end());
+      check_expected.push_back(GridStatus::INVALID);
+   }
+
+   std::vector<GridStatus> check_statuses(check_expected.size());
+   std::size_t check_valid = validateBatch(check_grids.data(), check_statuses.data(),
+                                           check_expected.size(), 9);
+   std::cout << "validate batch: "
+             << (check_statuses == check_expected && check_valid == 2 * num ?
+                 "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   std::cout << "\nRunning Format Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // a line round-trips through parseLine, and the writer emits the same bytes as
+   // formatGrid for every style
+   std::vector<char> format_text;
+   bool format_ok = true;
+   FILE *format_file = tmpfile();
+   {
+      BufferedWriter writer(format_file, 64);   // small buffer to exercise refills
+      for (int i = 0; i < num; i++) {
+         std::vector<uint8_t> cells, parsed(81);
+         loadCells(infile[i], cells);
+
+         char line[82];
+         format_ok &= formatGrid(cells.data(), 9, GridStyle::LINE, line) == 82;
+         format_ok &= parseLine(line, 81, parsed.data()) == 9 && parsed == cells;
+
+         for (GridStyle style : {GridStyle::LINE, GridStyle::PRETTY, GridStyle::PACKED}) {
+            std::size_t size = format_text.size();
+            format_text.resize(size + formattedSize(9, style));
+            format_text.resize(size + formatGrid(cells.data(), 9, style, &format_text[size]));
+            writer.writeGrid(cells.data(), 9, style);
+         }
+      }
+   }
+   std::vector<char> format_read(format_text.size() + 1);
+   rewind(format_file);
+   format_ok &= fread(format_read.data(), 1, format_read.size(), format_file) ==
+                format_text.size();
+   format_read.pop_back();
+   fclose(format_file);
+
+   std::cout << "format and write: "
+             << (format_ok && format_read == format_text ? "Pass" : "Fail ++++++++++++++++++++++")
+             << std::endl;
+
+   std::cout << "\nRunning Job Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // a corpus of every puzzle, solved in small shards, then resumed after losing a shard
+   char job_directory[] = "/tmp/sudoku-job-XXXXXX";
+   bool job_ok = mkdtemp(job_directory) != nullptr;
+   JobConfig job_config;
+   job_config.input = std::string(job_directory) + "/corpus.txt";
+   job_config.directory = std::string(job_directory) + "/out";
+   job_config.shard_bytes = 300;                // about three puzzles per shard
+   job_config.thread_count = 2;
+
+   std::string job_expected;
+   FILE *corpus = fopen(job_config.input.c_str(), "wb");
+   for (int round = 0; corpus && round < 4; round++) {
+      for (int i = 0; i < num; i++) {
+         std::vector<uint8_t> cells, expected;
+         loadCells(infile[i], cells);
+         loadCells(outfile[i], expected);
+
+         char line[82];
+         fwrite(line, 1, formatGrid(cells.data(), 9, GridStyle::LINE, line), corpus);
+         formatGrid(i == num-2 ? cells.data() : expected.data(), 9, GridStyle::LINE, line);
+         job_expected.append(line, 82);
+      }
+   }
+   job_ok &= corpus && fclose(corpus) == 0;
+
+   JobSummary job_summary;
+   std::string job_error;
+   job_ok &= runJob(job_config, job_summary, job_error);
+   job_ok &= job_summary.completed == job_summary.shards && job_summary.solved == 4 * (num-1);
+
+   // the lost shard also left an empty lock behind, as if its creator died before locking
+   unlink(shardPath(job_config.directory, 1, ".done").c_str());
+   FILE *empty_lock = fopen(shardPath(job_config.directory, 1, ".lock").c_str(), "wb");
+   job_ok &= empty_lock && fclose(empty_lock) == 0;
+   job_ok &= runJob(job_config, job_summary, job_error);
+   job_ok &= job_summary.completed == 1 && job_summary.skipped == job_summary.shards - 1;
+
+   std::string job_output;
+   for (std::size_t shard = 0; shard < job_summary.shards; shard++) {
+      std::vector<std::string> paths = {shardPath(job_config.directory, shard, ".out"),
+                                        shardPath(job_config.directory, shard, ".done")};
+      FILE *out = fopen(paths[0].c_str(), "rb");
+      char buffer[4096];
+      std::size_t got;
+      while (out && (got = fread(buffer, 1, sizeof(buffer), out)) > 0) {
+         job_output.append(buffer, got);
+      }
+      if (out) {
+         fclose(out);
+      }
+      unlink(paths[0].c_str());
+      unlink(paths[1].c_str());
+   }
+   unlink((job_config.directory + "/job.meta").c_str());
+   rmdir(job_config.directory.c_str());
+   unlink(job_config.input.c_str());
+   rmdir(job_directory);
+
+   std::cout << "sharded job (" << job_summary.shards << " shards): "
+             << (job_ok && job_output == job_expected ? "Pass" : "Fail ++++++++++++++++++++++")
+             << std::endl;
+
+   std::cout << "\nRunning Worker Pool Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   std::vector<int> cpu_list = parseCpuList("0-3,8,10-11\n");
+   std::cout << "cpulist: "
+             << (cpu_list == std::vector<int>({0, 1, 2, 3, 8, 10, 11}) &&
+                 parseCpuList("3-1").empty() && parseCpuList("x").empty() ?
+                 "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   // two nodes sharing whatever CPU the test runs on, so every worker can be pinned
+   Topology pool_topology = Topology::detect();
+   int pool_cpu = pool_topology.node_cpus[0][0];
+   pool_topology.node_cpus = {{pool_cpu}, {pool_cpu}};
+
+   std::vector<uint8_t> pool_batch, pool_expected;
+   for (int round = 0; round < 8; round++) {
+      for (int i = 0; i < num; i++) {
+         std::vector<uint8_t> cells, expected;
+         loadCells(infile[i], cells);
+         loadCells(outfile[i], expected);
+         pool_batch.insert(pool_batch.end(), cells.begin(), cells.end());
+         pool_expected.insert(pool_expected.end(), (i == num-2 ? cells : expected).begin(),
+                              (i == num-2 ? cells : expected).end());
+      }
+   }
+
+   const Pinning pinnings[] = {Pinning::NONE, Pinning::NODE, Pinning::CORE};
+   const char *pinning_names[] = {"none", "node", "core"};
+   for (Pinning pinning : pinnings) {
+      PoolConfig pool_config;
+      pool_config.thread_count = 3;
+      pool_config.pinning = pinning;
+      pool_config.chunk = 5;
+      WorkerPool pool(pool_config, pool_topology);
+
+      std::vector<uint8_t> pool_solutions(pool_batch.size());
+      std::size_t pool_solved = 0;
+      for (int repeat = 0; repeat < 2; repeat++) {      // the second batch reuses the workers
+         pool_solved = pool.solveBatch(pool_batch.data(), pool_solutions.data(), 8 * num, 9);
+      }
+      std::cout << "pinning " << pinning_names[(int) pinning] << ": "
+                << (pool_solved == (std::size_t) 8 * (num-1) && pool_solutions == pool_expected ?
+                    "Pass" : "Fail ++++++++++++++++++++++")
+                << " (" << pool.getThreadCount() << " workers on " << pool.getNodeCount()
+                << " nodes)" << std::endl;
+   }
+
+   std::cout << "\nRunning Pipeline Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   MpmcQueue<int> ring(2);
+   int ring_item = 0;
+   bool ring_ok = ring.tryPush(1) && ring.tryPush(2) && !ring.tryPush(3) &&
+                  ring.tryPop(ring_item) && ring_item == 1 && ring.tryPush(3) &&
+                  ring.tryPop(ring_item) && ring_item == 2 && ring.tryPop(ring_item) &&
+                  ring_item == 3 && !ring.tryPop(ring_item);
+   std::cout << "ring queue: " << (ring_ok ? "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   // the worker pool corpus with a blank and a malformed line, through batches of five
+   // lines, three at a time, so most batches wait for a free one and finish out of order
+   FILE *pipe_input = tmpfile();
+   std::string pipe_expected;
+   char pipe_line[82];
+   for (std::size_t i = 0; i < pool_batch.size() / 81; i++) {
+      formatGrid(pool_batch.data() + i * 81, 9, GridStyle::LINE, pipe_line);
+      fwrite(pipe_line, 1, 82, pipe_input);
+      formatGrid(pool_expected.data() + i * 81, 9, GridStyle::LINE, pipe_line);
+      pipe_expected.append(pipe_line, 82);
+      if (i == 10) {
+         fputs("\n123\n", pipe_input);
+      }
+   }
+   rewind(pipe_input);
+
+   PipelineConfig pipe_config;
+   pipe_config.thread_count = 3;
+   pipe_config.pinning = Pinning::NONE;
+   pipe_config.batch_lines = 5;
+   pipe_config.batches = 3;
+   PipelineStats pipe_stats;
+   FILE *pipe_output = tmpfile();
+   bool pipe_written = runPipeline(pipe_input, pipe_output, pipe_config, pipe_stats);
+
+   std::string pipe_result;
+   rewind(pipe_output);
+   for (int got; (got = (int) fread(pipe_line, 1, sizeof(pipe_line), pipe_output)) > 0; ) {
+      pipe_result.append(pipe_line, got);
+   }
+   fclose(pipe_input);
+   fclose(pipe_output);
+
+   std::cout << "ordered output: "
+             << (pipe_written && pipe_result == pipe_expected && pipe_stats.lines == 8 * num + 1 &&
+                 pipe_stats.puzzles == (unsigned long long) 8 * num &&
+                 pipe_stats.solved == (unsigned long long) 8 * (num-1) &&
+                 pipe_stats.malformed == 1 && pipe_stats.batches == (8 * num + 5) / 5 ?
+                 "Pass" : "Fail ++++++++++++++++++++++")
+             << " (" << pipe_stats.batches << " batches)" << std::endl;
+
+   std::cout << "\nRunning Histogram Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   bool buckets_ok = true;
+   for (int bucket = 0; bucket < Histogram::BUCKETS; bucket++) {
+      buckets_ok &= Histogram::bucketOf(Histogram::bucketTop(bucket)) == bucket &&
+                    (bucket == 0 || Histogram::bucketOf(Histogram::bucketTop(bucket - 1) + 1) ==
+                                    bucket);
+   }
+   std::cout << "buckets: " << (buckets_ok ? "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   // 1..100000 recorded by two "threads" and merged: percentiles may only round up, by
+   // less than one bucket
+   Histogram spread, spread_odd;
+   for (uint64_t value = 1; value <= 100000; value++) {
+      (value % 2 ? spread_odd : spread).record(value);
+   }
+   spread.merge(spread_odd);
+   bool spread_ok = spread.getCount() == 100000 && spread.getMax() == 100000 &&
+                    spread.valueAt(0) == 1 && spread.valueAt(100) == 100000;
+   for (double percent : {50.0, 90.0, 99.0, 99.9}) {
+      double exact = percent * 1000, got = (double) spread.valueAt(percent);
+      spread_ok &= got >= exact && got < exact * (1 + 1.0 / Histogram::SUB_COUNT);
+   }
+   std::cout << "percentiles: " << (spread_ok ? "Pass" : "Fail ++++++++++++++++++++++")
+             << " (p99.9 " << spread.valueAt(99.9) << ")" << std::endl;
+
+   const SolveProfile &pipe_profile = pipe_stats.profile;
+   std::cout << "pipeline profile: "
+             << (pipe_profile.latency.getCount() == pipe_stats.puzzles &&
+                 pipe_profile.nodes.getCount() == pipe_stats.puzzles &&
+                 pipe_profile.nodes.getMax() > 0 ? "Pass" : "Fail ++++++++++++++++++++++")
+             << " (p50 " << pipe_profile.latency.valueAt(50) / 1000 << " us, p99 "
+             << pipe_profile.latency.valueAt(99) / 1000 << " us, max nodes "
+             << pipe_profile.nodes.getMax() << ")" << std::endl;
+
+   std::cout << "\nRunning Trace Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // the trace must replay the search: one node at the root and one per decision that
+   // survived propagation, and exactly the backtracks the stats counted
+   char trace_path[] = "/tmp/sudoku-trace-XXXXXX";
+   int trace_fd = mkstemp(trace_path);
+   for (int i = 0; trace_fd >= 0 && i < num; i++) {
+      std::vector<uint8_t> cells;
+      int side = loadCells(infile[i], cells);
+      SolverPool::Lease context = SolverPool::acquire();
+
+      FILE *trace_file = fopen(trace_path, "wb");
+      BinaryTracer tracer(trace_file);
+      bool traced_solved = context->arm(cells.data(), side) &&
+                           context->solve(SearchOptions(), tracer);
+      tracer.flush();
+      fclose(trace_file);
+      SearchStats traced = context->getStats();
+      bool plain_solved = context->arm(cells.data(), side) && context->solve();
+
+      std::vector<TraceRecord> records;
+      unsigned long long counts[6] = {0, 0, 0, 0, 0, 0};
+      bool trace_ok = readTrace(trace_path, records) && !records.empty() &&
+                      records[0].kind == TraceKind::START && records[0].cell == side &&
+                      records.size() == tracer.getRecordCount();
+      for (const TraceRecord &record : records) {
+         counts[(int) record.kind]++;
+      }
+      trace_ok &= traced_solved == plain_solved && traced.nodes == context->getNodeCount() &&
+                  counts[(int) TraceKind::BACKTRACK] == traced.backtracks &&
+                  counts[(int) TraceKind::SOLUTION] == (traced_solved ? 1u : 0u) &&
+                  traced.nodes == 1 + counts[(int) TraceKind::DECISION] -
+                                  counts[(int) TraceKind::CONFLICT];
+
+      std::cout << "trace " << infile[i] << ": "
+                << (trace_ok ? "Pass" : "Fail ++++++++++++++++++++++") << " ("
+                << records.size() << " records)" << std::endl;
+   }
+   if (trace_fd >= 0) {
+      close(trace_fd);
+      unlink(trace_path);
+   }
+
+   std::cout << "\nRunning C API Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      int side = loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+
+      std::vector<uint8_t> api_solution(cells.size(), 0);
+      unsigned long long api_count = 0;
+      int solve_result = sudoku_solve(cells.data(), side, api_solution.data());
+      int count_result = sudoku_count(cells.data(), side, 2, &api_count);
+      bool api_ok = solve_result == (i != num-2 ? SUDOKU_OK : SUDOKU_NO_SOLUTION) &&
+                    (solve_result != SUDOKU_OK || api_solution == expected) &&
+                    count_result >= 0 && api_count == (i != num-2 ? 1u : 0u) &&
+                    sudoku_validate(cells.data(), side) == SUDOKU_GRID_PARTIAL &&
+                    (solve_result != SUDOKU_OK ||
+                     sudoku_validate(api_solution.data(), side) == SUDOKU_GRID_COMPLETE);
+
+      std::cout << "api " << infile[i] << ": " << (api_ok ? "Pass" : "Fail ++++++++++++++++++++++")
+                << std::endl;
+   }
+
+   // in place, across helper threads, with a result per board
+   std::vector<uint8_t> api_batch = pool_batch;
+   std::vector<int> api_results(8 * num, -9);
+   long long api_solved = sudoku_solve_batch(api_batch.data(), api_batch.data(),
+                                             api_results.data(), 8 * num, 9, 3);
+   std::vector<int> api_statuses(8 * num);
+   long long api_invalid = sudoku_validate_batch(api_batch.data(), api_statuses.data(),
+                                                 8 * num, 9);
+   bool batch_ok = api_solved == 8 * (num-1) && api_batch == pool_expected && api_invalid == 0 &&
+                   api_results[num-2] == SUDOKU_NO_SOLUTION && api_results[0] == SUDOKU_OK &&
+                   api_statuses[num-2] == SUDOKU_GRID_PARTIAL &&
+                   api_statuses[0] == SUDOKU_GRID_COMPLETE;
+   batch_ok &= sudoku_solve(api_batch.data(), 10, api_batch.data()) == SUDOKU_INVALID_ARGUMENT &&
+               sudoku_validate(nullptr, 9) == SUDOKU_INVALID_ARGUMENT;
+   std::cout << "api batch: " << (batch_ok ? "Pass" : "Fail ++++++++++++++++++++++")
+             << " (libsudoku " << sudoku_version() << ")" << std::endl;
+
+   std::cout << "\nRunning Giant Board Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // generated boards round-trip through the token line format and solve to a valid
+   // completion of their givens
+   SearchRandom giant_random(48);
+   for (int side : {36, 49, 64}) {
+      std::vector<uint8_t> puzzle(side * side), solution(side * side), parsed(side * side * 3);
+      generatePuzzle(side, 0.35, giant_random, puzzle.data(), solution.data());
+      std::vector<char> line(formattedSize(side, GridStyle::LINE));
+      std::size_t length = formatGrid(puzzle.data(), side, GridStyle::LINE, line.data());
+
+      bool giant_ok = validateGrid(solution.data(), side) == GridStatus::COMPLETE &&
+                      parseLine(line.data(), length - 1, parsed.data()) == side &&
+                      std::equal(puzzle.begin(), puzzle.end(), parsed.begin());
+      giant_ok &= sudoku_solve(puzzle.data(), side, solution.data()) == SUDOKU_OK &&
+                  validateGrid(solution.data(), side) == GridStatus::COMPLETE;
+      for (int x = 0; x < side * side; x++) {
+         giant_ok &= puzzle[x] == 0 || puzzle[x] == solution[x];
+      }
+
+      std::cout << side << " x " << side << ": "
+                << (giant_ok ? "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+   }
+
+   std::cout << "\nRunning Lockstep Batch Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   std::vector<uint8_t> batch, expected_batch;
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+      batch.insert(batch.end(), cells.begin(), cells.end());
+      expected_batch.insert(expected_batch.end(), expected.begin(), expected.end());
+   }
+
+   LockstepBatch &lockstep = SolverPool::lockstep();
+   std::vector<uint8_t> batch_solutions(batch.size());
+   std::size_t batch_solved = lockstep.solve(*SolverPool::acquire(), batch.data(),
+                                             batch_solutions.data(), num);
+
+   // the impossible puzzle comes back as given, so compare everything but that board
+   for (int x = 0; x < LockstepBatch::CELLS; ++x) {
+      batch_solutions[(num-2) * LockstepBatch::CELLS + x] =
+         expected_batch[(num-2) * LockstepBatch::CELLS + x];
+   }
+
+   if (batch_solved == (std::size_t) num-1 && batch_solutions == expected_batch) {
+      std::cout << "Pass";
+   } else {
+      std::cout << "Fail ++++++++++++++++++++++";
+   }
+   std::cout << " (" << lockstep.getStats().propagated << " by propagation, "
+             << lockstep.getStats().peeled << " peeled off, "
+             << lockstep.getStats().unsolvable << " unsolvable)" << std::endl;
+
+   std::cout << "\nRunning Variant Region Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   const char *variant_names[] = {"diagonal", "windoku"};
+   RegionModel variants[] = {RegionModel::diagonal(9), RegionModel::windoku(9)};
+   for (int v = 0; v < 2; v++) {
+      std::vector<uint8_t> cells, board(81);
+      loadCells("tests/sudoku-empty.txt", cells);
+
+      SolverPool::Lease context = SolverPool::acquire();
+      bool context_ok = context->arm(cells.data(), variants[v]) && context->solve();
+      context->storeCells(board.data());
+      context_ok = context_ok && satisfies(variants[v], board);
+
+      puzzle.loadFromFile("tests/sudoku-empty.txt");
+      bool sudoku_ok = puzzle.setRegions(variants[v]) && puzzle.solve();
+      puzzle.storeCells(board.data());
+      sudoku_ok = sudoku_ok && satisfies(variants[v], board);
+
+      std::cout << variant_names[v] << ": "
+                << (context_ok && sudoku_ok ? "Pass" : "Fail ++++++++++++++++++++++")
+                << std::endl;
+   }
+
+   // a side with no square boxes gets no standard model, and a board of it is refused
+   std::vector<uint8_t> six_cells(36, 0);
+   puzzle.loadFromCells(six_cells.data(), 6);
+   bool six_ok = RegionModel::standard(6).getSideLength() == 0 &&
+                 RegionModel::diagonal(6).getSideLength() == 0 &&
+                 RegionModel::windoku(6).getSideLength() == 0 &&
+                 puzzle.getSideLength() == 9 && puzzle.solve();
+   std::cout << "6 x 6 standard: " << (six_ok ? "Pass" : "Fail ++++++++++++++++++++++")
+             << std::endl;
+
+   std::cout << "\nRunning SAT Engine Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells, expected;
+      int side = loadCells(infile[i], cells);
+      loadCells(outfile[i], expected);
+
+      SatSudoku sat;
+      bool solved = sat.arm(cells.data(), side) && sat.solve();
+      sat.storeCells(cells.data());
+
+      std::cout << "sat " << infile[i] << ": ";
+      if (solved != (i != num-2) || (solved && cells != expected)) {
+         std::cout << "Fail ++++++++++++++++++++++" << std::endl;
+      } else {
+         std::cout << "Pass (" << sat.getStats().conflicts << " conflicts)" << std::endl;
+      }
+   }
+
+   // a clause-learning solve leaves a finished search that saves and restores
+   SearchRandom sat_random(25);
+   std::vector<uint8_t> sat_puzzle(625), sat_cells(625), sat_state;
+   generatePuzzle(25, 0.6, sat_random, sat_puzzle.data());
+   Sudoku sat_board;
+   sat_board.loadFromCells(sat_puzzle.data(), 25);
+   bool sat_solved = sat_board.solveSat();
+   sat_board.saveSearch(sat_state);
+   Sudoku sat_restored;
+   bool sat_ok = sat_solved && sat_restored.loadSearch(sat_state) &&
+                 sat_restored.continueSearch() == SearchStatus::SOLVED;
+   sat_restored.storeCells(sat_cells.data());
+   sat_ok &= validateGrid(sat_cells.data(), 25) == GridStatus::COMPLETE;
+   for (int x = 0; x < 625; x++) {
+      sat_ok &= sat_puzzle[x] == 0 || sat_puzzle[x] == sat_cells[x];
+   }
+   std::cout << "solveSat 25 x 25 then saveSearch: "
+             << (sat_ok ? "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
+   std::cout << "\nRunning Completion Count Tests" << std::endl;
+   std::cout << "------------------" << std::endl << std::endl;
+
+   // each solution with its last band emptied, against enumerating the completions
+   SolverPool::Lease enumerator = SolverPool::acquire();
+   for (int i = 0; i < num; i++) {
+      std::vector<uint8_t> cells;
+      int side = loadCells(outfile[i], cells);
+      std::fill(cells.begin() + 6 * side, cells.end(), 0);
+
+      CompletionCount completions;
+      bool counted = BandCounter(3, 3).count(cells.data(), completions);
+      unsigned long long expected = enumerator->arm(cells.data(), side) ?
+                                    enumerator->countSolutions(0) : 0;
+      std::cout << "band count " << outfile[i] << ": "
+                << (counted && completions == CompletionCount(expected) ?
+                    "Pass" : "Fail ++++++++++++++++++++++")
+                << " (" << completions.toString() << ")" << std::endl;
+   }
+
+   const int box_shapes[3][2] = {{2, 2}, {2, 3}, {3, 2}};
+   const char *empty_counts[3] = {"288", "28200960", "28200960"};
+   for (int s = 0; s < 3; s++) {
+      int side = box_shapes[s][0] * box_shapes[s][1];
+      std::vector<uint8_t> cells(side * side, 0);
+      BandCounter counter(box_shapes[s][0], box_shapes[s][1]);
+      CompletionCount completions;
+      bool counted = counter.count(cells.data(), completions);
+      std::cout << "count empty " << box_shapes[s][0] << " x " << box_shapes[s][1]
+                << " boxes: "
+                << (counted && completions.toString() == empty_counts[s] ?
+                    "Pass" : "Fail ++++++++++++++++++++++")
+                << " (" << counter.getStateCount() << " states)" << std::endl;
+   }
+
+   // 128-bit arithmetic past 2^64, and overflow past 2^128
+   CompletionCount wide(1ull << 63);
+   wide *= 6;
+   wide += CompletionCount(7);
+   CompletionCount past = wide;
+   past *= 1ull << 63;
+   past *= 1ull << 62;
+   std::cout << "count arithmetic: "
+             << (wide.toString() == "55340232221128654855" && past.overflow ?
+                 "Pass" : "Fail ++++++++++++++++++++++") << std::endl;
+
    //std::cout << "Press enter to continue" << std::endl;
    //cin.get();
 